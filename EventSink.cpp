@@ -0,0 +1,213 @@
+#include "EventSink.h"
+#include "KeyboardDevice.h"
+#include "MouseDevice.h"
+#include "GestureRecognizer.h"
+#include "MemoryMonitor.h"
+#include "HostClock.h"
+
+void SerialTextSink::onKey(uint8_t keyCode, bool pressed, uint8_t modifiers) {
+  Serial.print(F("Keyboard: Key '"));
+  Serial.print(getKeyName(keyCode));
+  Serial.print(F("' "));
+  Serial.print(pressed ? F("pressed") : F("released"));
+
+  String modStr = getModifierString(modifiers);
+  MEM_PROBE(MEM_PATH_KEYBOARD);
+  if (modStr.length() > 0) {
+    Serial.print(F(" ("));
+    Serial.print(modStr);
+    Serial.print(F(")"));
+  }
+  endLine();
+}
+
+void SerialTextSink::onModifier(uint8_t modifier, bool pressed) {
+  Serial.print(F("Keyboard: "));
+  switch (modifier) {
+    case MOD_LEFT_CTRL: Serial.print(F("Left Ctrl ")); break;
+    case MOD_LEFT_SHIFT: Serial.print(F("Left Shift ")); break;
+    case MOD_LEFT_ALT: Serial.print(F("Left Alt ")); break;
+    case MOD_LEFT_WIN: Serial.print(F("Left Win ")); break;
+    case MOD_RIGHT_CTRL: Serial.print(F("Right Ctrl ")); break;
+    case MOD_RIGHT_SHIFT: Serial.print(F("Right Shift ")); break;
+    case MOD_RIGHT_ALT: Serial.print(F("Right Alt ")); break;
+    case MOD_RIGHT_WIN: Serial.print(F("Right Win ")); break;
+  }
+  Serial.print(pressed ? F("pressed") : F("released"));
+  endLine();
+}
+
+void SerialTextSink::onButton(uint8_t button, bool pressed) {
+  Serial.print(F("Mouse: "));
+  switch (button) {
+    case MOUSE_LEFT_BUTTON: Serial.print(F("Left")); break;
+    case MOUSE_RIGHT_BUTTON: Serial.print(F("Right")); break;
+    case MOUSE_MIDDLE_BUTTON: Serial.print(F("Middle")); break;
+    default: Serial.print(F("Unknown")); break;
+  }
+  Serial.print(F(" button "));
+  Serial.print(pressed ? F("pressed") : F("released"));
+  endLine();
+}
+
+void SerialTextSink::onMotion(int8_t dx, int8_t dy, int16_t x, int16_t y) {
+  MEM_PROBE(MEM_PATH_MOUSE);
+  Serial.print(F("Mouse: Moved to ("));
+  Serial.print(x);
+  Serial.print(F(", "));
+  Serial.print(y);
+  // 附带本次相对位移，主机无需由绝对坐标反推
+  Serial.print(F(") by ("));
+  Serial.print(dx);
+  Serial.print(F(", "));
+  Serial.print(dy);
+  Serial.print(F(")"));
+  endLine();
+}
+
+void SerialTextSink::onWheel(int8_t wheel) {
+  Serial.print(F("Mouse: Wheel "));
+  if (wheel > 0) {
+    Serial.print(F("up "));
+    Serial.print(wheel);
+  } else {
+    Serial.print(F("down "));
+    Serial.print(-wheel);
+  }
+  endLine();
+}
+
+void SerialTextSink::onGesture(uint8_t gesture) {
+  Serial.print(F("Mouse: Gesture "));
+  Serial.print(GestureRecognizer::getGestureName(gesture));
+  endLine();
+}
+
+void SerialTextSink::endLine() {
+#if USE_HOST_CLOCK
+  // 同步后附加主机时间戳 " @<us>"
+  if (HostClock::isSynced()) {
+    Serial.print(F(" @"));
+    Serial.print(HostClock::eventTime());
+  }
+#endif
+  Serial.println();
+}
+
+const char* SerialTextSink::getKeyName(uint8_t keyCode) {
+  // USB HID键盘扫描码到字符的映射
+  switch (keyCode) {
+    case 0x04: return "A";
+    case 0x05: return "B";
+    case 0x06: return "C";
+    case 0x07: return "D";
+    case 0x08: return "E";
+    case 0x09: return "F";
+    case 0x0A: return "G";
+    case 0x0B: return "H";
+    case 0x0C: return "I";
+    case 0x0D: return "J";
+    case 0x0E: return "K";
+    case 0x0F: return "L";
+    case 0x10: return "M";
+    case 0x11: return "N";
+    case 0x12: return "O";
+    case 0x13: return "P";
+    case 0x14: return "Q";
+    case 0x15: return "R";
+    case 0x16: return "S";
+    case 0x17: return "T";
+    case 0x18: return "U";
+    case 0x19: return "V";
+    case 0x1A: return "W";
+    case 0x1B: return "X";
+    case 0x1C: return "Y";
+    case 0x1D: return "Z";
+    case 0x1E: return "1";
+    case 0x1F: return "2";
+    case 0x20: return "3";
+    case 0x21: return "4";
+    case 0x22: return "5";
+    case 0x23: return "6";
+    case 0x24: return "7";
+    case 0x25: return "8";
+    case 0x26: return "9";
+    case 0x27: return "0";
+    case 0x28: return "ENTER";
+    case 0x29: return "ESC";
+    case 0x2A: return "BACKSPACE";
+    case 0x2B: return "TAB";
+    case 0x2C: return "SPACE";
+    case 0x2D: return "-";
+    case 0x2E: return "=";
+    case 0x2F: return "[";
+    case 0x30: return "]";
+    case 0x31: return "\\";
+    case 0x33: return ";";
+    case 0x34: return "'";
+    case 0x35: return "`";
+    case 0x36: return ",";
+    case 0x37: return ".";
+    case 0x38: return "/";
+    case 0x39: return "CAPS";
+    case 0x3A: return "F1";
+    case 0x3B: return "F2";
+    case 0x3C: return "F3";
+    case 0x3D: return "F4";
+    case 0x3E: return "F5";
+    case 0x3F: return "F6";
+    case 0x40: return "F7";
+    case 0x41: return "F8";
+    case 0x42: return "F9";
+    case 0x43: return "F10";
+    case 0x44: return "F11";
+    case 0x45: return "F12";
+    case 0x4F: return "RIGHT";
+    case 0x50: return "LEFT";
+    case 0x51: return "DOWN";
+    case 0x52: return "UP";
+    default:
+      static char unknownKey[8];
+      sprintf(unknownKey, "0x%02X", keyCode);
+      return unknownKey;
+  }
+}
+
+String SerialTextSink::getModifierString(uint8_t modifiers) {
+  String result = "";
+
+  if (modifiers & MOD_LEFT_CTRL) {
+    if (result.length() > 0) result += "+";
+    result += "LCtrl";
+  }
+  if (modifiers & MOD_RIGHT_CTRL) {
+    if (result.length() > 0) result += "+";
+    result += "RCtrl";
+  }
+  if (modifiers & MOD_LEFT_SHIFT) {
+    if (result.length() > 0) result += "+";
+    result += "LShift";
+  }
+  if (modifiers & MOD_RIGHT_SHIFT) {
+    if (result.length() > 0) result += "+";
+    result += "RShift";
+  }
+  if (modifiers & MOD_LEFT_ALT) {
+    if (result.length() > 0) result += "+";
+    result += "LAlt";
+  }
+  if (modifiers & MOD_RIGHT_ALT) {
+    if (result.length() > 0) result += "+";
+    result += "RAlt";
+  }
+  if (modifiers & MOD_LEFT_WIN) {
+    if (result.length() > 0) result += "+";
+    result += "LWin";
+  }
+  if (modifiers & MOD_RIGHT_WIN) {
+    if (result.length() > 0) result += "+";
+    result += "RWin";
+  }
+
+  return result;
+}
\ No newline at end of file
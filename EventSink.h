@@ -0,0 +1,91 @@
+#ifndef __EVENTSINK_h__
+#define __EVENTSINK_h__
+
+#include <Arduino.h>
+
+// 事件类型位掩码
+#define EVENT_KEY 0x01
+#define EVENT_MODIFIER 0x02
+#define EVENT_BUTTON 0x04
+#define EVENT_MOTION 0x08
+#define EVENT_WHEEL 0x10
+#define EVENT_GESTURE 0x20
+#define EVENT_ALL 0x3F
+
+// 事件接收器基类 - 编译期分发
+// 自定义接收器继承该类，隐藏需要的静态处理函数并设置 events 掩码。
+// 设备类通过 ActiveSink 直接调用（无虚函数/函数指针），
+// 未订阅的事件连同其检测代码在编译期被消除。
+struct EventSinkBase {
+  static const uint8_t events = 0;
+
+  static inline void onKey(uint8_t, bool, uint8_t) {}          // 按键码, 按下, 修饰符
+  static inline void onModifier(uint8_t, bool) {}              // 修饰符位, 按下
+  static inline void onButton(uint8_t, bool) {}                // 鼠标按键位, 按下
+  static inline void onMotion(int8_t, int8_t, int16_t, int16_t) {}  // dx, dy, 绝对x, 绝对y
+  static inline void onWheel(int8_t) {}                        // 滚轮增量
+  static inline void onGesture(uint8_t) {}                     // 笔势编号
+};
+
+// 串口文本输出接收器（原有输出格式）
+struct SerialTextSink : EventSinkBase {
+  static const uint8_t events = EVENT_ALL;
+
+  static void onKey(uint8_t keyCode, bool pressed, uint8_t modifiers);
+  static void onModifier(uint8_t modifier, bool pressed);
+  static void onButton(uint8_t button, bool pressed);
+  static void onMotion(int8_t dx, int8_t dy, int16_t x, int16_t y);
+  static void onWheel(int8_t wheel);
+  static void onGesture(uint8_t gesture);
+
+  // 获取按键名称
+  static const char* getKeyName(uint8_t keyCode);
+
+  // 获取修饰符字符串
+  static String getModifierString(uint8_t modifiers);
+
+  // 结束一行事件输出（附加时间戳）
+  static void endLine();
+};
+
+// 组合两个接收器，按订阅掩码分别转发
+template <class A, class B>
+struct EventSinkPair {
+  static const uint8_t events = A::events | B::events;
+
+  static inline void onKey(uint8_t keyCode, bool pressed, uint8_t modifiers) {
+    if (A::events & EVENT_KEY) A::onKey(keyCode, pressed, modifiers);
+    if (B::events & EVENT_KEY) B::onKey(keyCode, pressed, modifiers);
+  }
+  static inline void onModifier(uint8_t modifier, bool pressed) {
+    if (A::events & EVENT_MODIFIER) A::onModifier(modifier, pressed);
+    if (B::events & EVENT_MODIFIER) B::onModifier(modifier, pressed);
+  }
+  static inline void onButton(uint8_t button, bool pressed) {
+    if (A::events & EVENT_BUTTON) A::onButton(button, pressed);
+    if (B::events & EVENT_BUTTON) B::onButton(button, pressed);
+  }
+  static inline void onMotion(int8_t dx, int8_t dy, int16_t x, int16_t y) {
+    if (A::events & EVENT_MOTION) A::onMotion(dx, dy, x, y);
+    if (B::events & EVENT_MOTION) B::onMotion(dx, dy, x, y);
+  }
+  static inline void onWheel(int8_t wheel) {
+    if (A::events & EVENT_WHEEL) A::onWheel(wheel);
+    if (B::events & EVENT_WHEEL) B::onWheel(wheel);
+  }
+  static inline void onGesture(uint8_t gesture) {
+    if (A::events & EVENT_GESTURE) A::onGesture(gesture);
+    if (B::events & EVENT_GESTURE) B::onGesture(gesture);
+  }
+};
+
+// 自定义接收器及其选择写在 UserSink.h 中（所有编译单元都包含本文件，保证选择一致）
+#include "UserSink.h"
+
+// 当前使用的事件接收器（UserSink.h 未选择时使用串口文本输出）
+#ifndef EVENT_SINK
+#define EVENT_SINK SerialTextSink
+#endif
+typedef EVENT_SINK ActiveSink;
+
+#endif  //__EVENTSINK_h__
@@ -0,0 +1,166 @@
+#include "GestureRecognizer.h"
+
+#define GESTURE_INDEL_COST 2  // 多出或缺少一个方向的代价
+
+// 笔势模板表（Flash）
+static const GestureTemplate gestureTemplates[GESTURE_COUNT] PROGMEM = {
+  { 1, { DIR_RIGHT } },
+  { 1, { DIR_LEFT } },
+  { 1, { DIR_UP } },
+  { 1, { DIR_DOWN } },
+  { 2, { DIR_DOWN, DIR_RIGHT } },
+  { 2, { DIR_DOWN, DIR_LEFT } },
+  { 2, { DIR_UP, DIR_DOWN } },
+  { 2, { DIR_LEFT, DIR_RIGHT } },
+};
+
+static const char gestureName0[] PROGMEM = "Right";
+static const char gestureName1[] PROGMEM = "Left";
+static const char gestureName2[] PROGMEM = "Up";
+static const char gestureName3[] PROGMEM = "Down";
+static const char gestureName4[] PROGMEM = "Down-Right";
+static const char gestureName5[] PROGMEM = "Down-Left";
+static const char gestureName6[] PROGMEM = "Up-Down";
+static const char gestureName7[] PROGMEM = "Left-Right";
+
+static const char *const gestureNames[GESTURE_COUNT] PROGMEM = {
+  gestureName0, gestureName1, gestureName2, gestureName3,
+  gestureName4, gestureName5, gestureName6, gestureName7
+};
+
+GestureRecognizer::GestureRecognizer() {
+  reset();
+}
+
+void GestureRecognizer::reset() {
+  accX = 0;
+  accY = 0;
+  pendingDir = DIR_NONE;
+  pendingCount = 0;
+  lastDir = DIR_NONE;
+  strokeLen = 0;
+  active = false;
+  memset(rows, 0, sizeof(rows));
+}
+
+void GestureRecognizer::begin() {
+  reset();
+  active = true;
+
+  // 空笔画到模板前缀的代价：插入 j 个方向
+  for (uint8_t t = 0; t < GESTURE_COUNT; t++) {
+    for (uint8_t j = 0; j <= GESTURE_MAX_LEN; j++) {
+      rows[t][j] = j * GESTURE_INDEL_COST;
+    }
+  }
+}
+
+void GestureRecognizer::addMotion(int8_t dx, int8_t dy) {
+  if (!active) return;
+
+  accX += dx;
+  accY += dy;
+
+  // 累积位移不足一个步长时继续积累
+  if (abs(accX) < GESTURE_STEP && abs(accY) < GESTURE_STEP) return;
+
+  uint8_t dir = quantize(accX, accY);
+  accX = 0;
+  accY = 0;
+
+  // 连续出现 GESTURE_CONFIRM 次才确认，过滤抖动
+  if (dir == pendingDir) {
+    if (pendingCount < GESTURE_CONFIRM) pendingCount++;
+  } else {
+    pendingDir = dir;
+    pendingCount = 1;
+  }
+
+  if (pendingCount == GESTURE_CONFIRM && dir != lastDir) {
+    lastDir = dir;
+    feed(dir);
+  }
+}
+
+uint8_t GestureRecognizer::end() {
+  if (!active) return GESTURE_NONE;
+  active = false;
+
+  if (strokeLen == 0) return GESTURE_NONE;
+
+  // 记录最低与次低代价；并列时笔画有歧义（如 上→右 与“右”“上”代价相同），不触发
+  uint8_t best = GESTURE_NONE;
+  uint8_t bestCost = 0xFF;
+  uint8_t secondCost = 0xFF;
+  for (uint8_t t = 0; t < GESTURE_COUNT; t++) {
+    uint8_t len = pgm_read_byte(&gestureTemplates[t].length);
+    uint8_t cost = rows[t][len];
+    if (cost < bestCost) {
+      secondCost = bestCost;
+      bestCost = cost;
+      best = t;
+    } else if (cost < secondCost) {
+      secondCost = cost;
+    }
+  }
+
+  if (bestCost > GESTURE_TOLERANCE || secondCost <= bestCost) return GESTURE_NONE;
+  return best;
+}
+
+const __FlashStringHelper* GestureRecognizer::getGestureName(uint8_t id) {
+  if (id >= GESTURE_COUNT) return F("Unknown");
+  return reinterpret_cast<const __FlashStringHelper*>(pgm_read_ptr(&gestureNames[id]));
+}
+
+uint8_t GestureRecognizer::quantize(int16_t dx, int16_t dy) {
+  // tan(22.5°) ≈ 5/12，仅用整数比较划分 8 个扇区
+  int16_t ax = abs(dx);
+  int16_t ay = abs(dy);
+
+  if (ay * 12 <= ax * 5) {
+    return dx > 0 ? DIR_RIGHT : DIR_LEFT;
+  }
+  if (ax * 12 <= ay * 5) {
+    return dy > 0 ? DIR_DOWN : DIR_UP;
+  }
+  if (dx > 0) {
+    return dy > 0 ? DIR_DOWN_RIGHT : DIR_UP_RIGHT;
+  }
+  return dy > 0 ? DIR_DOWN_LEFT : DIR_UP_LEFT;
+}
+
+uint8_t GestureRecognizer::substituteCost(uint8_t a, uint8_t b) {
+  uint8_t diff = (a - b) & 7;
+  if (diff == 0) return 0;
+  if (diff == 1 || diff == 7) return 1;
+  return 3;
+}
+
+void GestureRecognizer::feed(uint8_t dir) {
+  if (strokeLen < 0xFF) strokeLen++;
+
+  for (uint8_t t = 0; t < GESTURE_COUNT; t++) {
+    uint8_t len = pgm_read_byte(&gestureTemplates[t].length);
+    uint8_t *row = rows[t];
+
+    // 单行原地更新：diag 保存上一行的 row[j-1]
+    uint8_t diag = row[0];
+    uint16_t cost = row[0] + GESTURE_INDEL_COST;
+    row[0] = cost > 0xFF ? 0xFF : cost;
+
+    for (uint8_t j = 1; j <= len; j++) {
+      uint8_t up = row[j];
+      uint8_t expected = pgm_read_byte(&gestureTemplates[t].dirs[j - 1]);
+
+      cost = diag + substituteCost(dir, expected);
+      uint16_t del = up + GESTURE_INDEL_COST;
+      uint16_t ins = row[j - 1] + GESTURE_INDEL_COST;
+      if (del < cost) cost = del;
+      if (ins < cost) cost = ins;
+
+      diag = up;
+      row[j] = cost > 0xFF ? 0xFF : cost;
+    }
+  }
+}
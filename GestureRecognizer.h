@@ -0,0 +1,85 @@
+#ifndef __GESTURERECOGNIZER_h__
+#define __GESTURERECOGNIZER_h__
+
+#include <Arduino.h>
+
+// 鼠标笔势识别配置
+#define USE_GESTURES 1
+#define GESTURE_BUTTON MOUSE_RIGHT_BUTTON  // 按住该按键拖动为笔势
+#define GESTURE_SUPPRESS_MOTION 1     // 笔势期间不输出移动事件
+#define GESTURE_STEP 16               // 累积位移达到该值时量化一个方向
+#define GESTURE_CONFIRM 2             // 方向连续出现次数，过滤抖动
+#define GESTURE_MAX_LEN 4             // 模板最大方向数
+#define GESTURE_COUNT 8               // 模板数量
+#define GESTURE_TOLERANCE 2           // 可接受的最大编辑代价
+#define GESTURE_NONE 0xFF
+
+// 方向编码（屏幕坐标，Y 向下为正）
+enum GestureDirection {
+  DIR_RIGHT = 0,
+  DIR_DOWN_RIGHT = 1,
+  DIR_DOWN = 2,
+  DIR_DOWN_LEFT = 3,
+  DIR_LEFT = 4,
+  DIR_UP_LEFT = 5,
+  DIR_UP = 6,
+  DIR_UP_RIGHT = 7,
+  DIR_NONE = 0xFF
+};
+
+// 笔势模板（存放在 Flash 中）
+struct GestureTemplate {
+  uint8_t length;
+  uint8_t dirs[GESTURE_MAX_LEN];
+};
+
+// 笔势识别器 - 整数增量匹配
+// 移动量化为方向码后，逐个送入每个模板的编辑距离行，
+// 笔画结束时只需比较各模板末列即可得到结果。
+class GestureRecognizer {
+public:
+  GestureRecognizer();
+
+  // 重置识别器状态
+  void reset();
+
+  // 笔画开始
+  void begin();
+
+  // 累积一次相对移动
+  void addMotion(int8_t dx, int8_t dy);
+
+  // 笔画结束，返回识别到的笔势编号；超出容差或与另一模板代价并列时返回 GESTURE_NONE
+  uint8_t end();
+
+  // 是否正在记录笔画
+  inline bool isActive() {
+    return active;
+  }
+
+  // 获取笔势名称
+  static const __FlashStringHelper* getGestureName(uint8_t id);
+
+private:
+  // 位移向量量化为 8 方向
+  static uint8_t quantize(int16_t dx, int16_t dy);
+
+  // 方向替换代价：相同 0，相邻 1，其余 3
+  static uint8_t substituteCost(uint8_t a, uint8_t b);
+
+  // 送入一个确认的方向码，增量更新所有模板
+  void feed(uint8_t dir);
+
+  int16_t accX;            // 未量化的累积位移
+  int16_t accY;
+  uint8_t pendingDir;      // 待确认的方向
+  uint8_t pendingCount;    // 待确认方向的连续次数
+  uint8_t lastDir;         // 最近确认的方向（去重）
+  uint8_t strokeLen;       // 已确认的方向数
+  bool active;
+
+  // 编辑距离行：rows[t][j] 为当前笔画与模板 t 前 j 个方向的代价
+  uint8_t rows[GESTURE_COUNT][GESTURE_MAX_LEN + 1];
+};
+
+#endif  //__GESTURERECOGNIZER_h__
@@ -1,16 +1,18 @@
 #include "HIDManager.h"
+#include "MemoryMonitor.h"
+#include "HostClock.h"
+#include "InputSnapshot.h"
+
+// 按类型分开的处理器池，替代每个实例内嵌的键盘和鼠标对象
+static HandlerPool<KeyboardDevice, KEYBOARD_POOL_SIZE> keyboardPool;
+static HandlerPool<MouseDevice, MOUSE_POOL_SIZE> mousePool;
 
 HIDManager::HIDManager(USB *p)
   : HIDUniversal(p),
-    keyboard(),  // 静态初始化
-    mouse(),     // 静态初始化
     totalDevices(0),
-    currentDevice(-1) {
-
-  // 初始化状态位标志
-  status.keyboardConnected = false;
-  status.mouseConnected = false;
-  status._reserved = 0;
+    currentDevice(-1),
+    keyboard(nullptr),
+    mouse(nullptr) {
 
   // 内存优化的设备槽位初始化
   for (uint8_t i = 0; i < MAX_DEVICES; i++) {
@@ -27,13 +29,63 @@ HIDManager::HIDManager(USB *p)
 }
 
 HIDManager::~HIDManager() {
-  // 静态对象不需要手动释放内存
+  releaseHandlers();
 }
 
 void HIDManager::init() {
-  // 初始化静态设备处理器
-  keyboard.reset();  // 重置键盘设备状态
-  mouse.reset();     // 重置鼠标设备状态
+  // 归还可能残留的处理器
+  releaseHandlers();
+}
+
+uint8_t HIDManager::Release() {
+  // USB断开：归还处理器并清空设备槽位
+  releaseHandlers();
+  for (uint8_t i = 0; i < MAX_DEVICES; i++) {
+    if (devices[i].active) {
+      LOG2(MSG_DEVICE_DISCONNECTED, devices[i].vid, devices[i].pid);
+    }
+    devices[i].active = false;
+  }
+  totalDevices = 0;
+  currentDevice = -1;
+  return HIDUniversal::Release();
+}
+
+void HIDManager::acquireHandler(DeviceType type) {
+  if (type == DEVICE_KEYBOARD && keyboard == nullptr) {
+    keyboard = keyboardPool.acquire();
+    if (keyboard != nullptr) {
+      keyboard->init();
+    } else {
+      LOG1(MSG_HANDLER_POOL_EMPTY, (uint8_t)type);
+    }
+  } else if (type == DEVICE_MOUSE && mouse == nullptr) {
+    mouse = mousePool.acquire();
+    if (mouse != nullptr) {
+      mouse->init();
+    } else {
+      LOG1(MSG_HANDLER_POOL_EMPTY, (uint8_t)type);
+    }
+  }
+}
+
+void HIDManager::releaseHandlers() {
+#if USE_INPUT_SNAPSHOT
+  // 设备断开时松开其按键，避免快照中残留按下状态
+  inputSnapshot.beginWrite();
+  if (keyboard != nullptr) keyboard->clearSnapshot();
+  if (mouse != nullptr) inputSnapshot.setButtons(0);
+  inputSnapshot.endWrite();
+#endif
+
+  if (keyboard != nullptr) {
+    keyboardPool.release(keyboard);
+    keyboard = nullptr;
+  }
+  if (mouse != nullptr) {
+    mousePool.release(mouse);
+    mouse = nullptr;
+  }
 }
 
 uint8_t HIDManager::OnInitSuccessful() {
@@ -43,6 +95,10 @@ uint8_t HIDManager::OnInitSuccessful() {
 
 void HIDManager::ParseHIDData(USBHID *hid, bool is_rpt_id, uint8_t len, uint8_t *buf) {
   if (len == 0 || buf == nullptr) return;
+  MEM_PROBE(MEM_PATH_PARSE_HID);
+#if USE_HOST_CLOCK
+  HostClock::stamp();  // 本报告产生的事件共用同一时间戳
+#endif
 
   // 优化：每个HIDManager实例只处理一个设备
   if (totalDevices == 0) {
@@ -53,19 +109,18 @@ void HIDManager::ParseHIDData(USBHID *hid, bool is_rpt_id, uint8_t len, uint8_t
       devices[currentDevice].deviceType = detectedType;
       devices[currentDevice].bufferSize = len;
 
+      // 首个报告的原始数据，便于诊断未知设备
+      Log::begin(MSG_FIRST_REPORT);
+      Log::arg(len);
+      Log::buf(buf, len);
+      Log::end();
+
       if (detectedType == DEVICE_KEYBOARD) {
-        Serial.println(F("Keyboard detected"));
-        status.keyboardConnected = true;
-        if (!keyboard.initialized) {
-          keyboard.init();
-        }
+        LOG2(MSG_KEYBOARD_DETECTED, (uint16_t)HIDUniversal::VID, (uint16_t)HIDUniversal::PID);
       } else if (detectedType == DEVICE_MOUSE) {
-        Serial.println(F("Mouse detected"));
-        status.mouseConnected = true;
-        if (!mouse.initialized) {
-          mouse.init();
-        }
+        LOG2(MSG_MOUSE_DETECTED, (uint16_t)HIDUniversal::VID, (uint16_t)HIDUniversal::PID);
       }
+      acquireHandler(detectedType);
     }
   } else {
     currentDevice = 0;  // 单设备实例
@@ -93,6 +148,7 @@ int8_t HIDManager::createDeviceSlot(uint16_t vid, uint16_t pid) {
       devices[i].pid = pid;
       devices[i].active = true;
       devices[i].lastActivity = getRelativeTime();
+      memset(devices[i].buffer, 0, BUFFER_SIZE);  // 清除上一次连接残留的数据
       totalDevices++;
       return i;
     }
@@ -114,8 +170,7 @@ DeviceType HIDManager::identifyDeviceType(uint8_t len, uint8_t *buf) {
     return DEVICE_KEYBOARD;
   }
 
-  Serial.print(F("Unknown device type with report length: "));
-  Serial.println(len);
+  LOG3(MSG_UNKNOWN_DEVICE, len, (uint16_t)HIDUniversal::VID, (uint16_t)HIDUniversal::PID);
   return DEVICE_UNKNOWN;
 }
 
@@ -132,11 +187,11 @@ void HIDManager::processDeviceData(int8_t deviceIndex, uint8_t len, uint8_t *buf
 
   DeviceSlot &device = devices[deviceIndex];
 
-  // 优化的设备处理器调用（去除指针检查）
-  if (device.deviceType == DEVICE_KEYBOARD && status.keyboardConnected) {
-    keyboard.parseKeyboardReport(len, buf);
-  } else if (device.deviceType == DEVICE_MOUSE && status.mouseConnected) {
-    mouse.parseMouseReport(len, buf);
+  // 处理器为空表示池已满或类型未知
+  if (device.deviceType == DEVICE_KEYBOARD && keyboard != nullptr) {
+    keyboard->parseKeyboardReport(len, buf);
+  } else if (device.deviceType == DEVICE_MOUSE && mouse != nullptr) {
+    mouse->parseMouseReport(len, buf);
   }
 }
 
@@ -146,19 +201,16 @@ void HIDManager::checkDeviceStatus() {
 
   for (uint8_t i = 0; i < MAX_DEVICES; i++) {
     if (devices[i].active) {
+      // 已分配处理器的设备只在 Release()（USB断开）时回收：
+      // 按住按键不动时没有新报告，超时回收会丢失按下状态和坐标
+      if (hasHandler(devices[i].deviceType)) continue;
+
       // 使用16位时间差检查（处理溢出情况）
       uint16_t timeDiff = (uint16_t)(currentTime - devices[i].lastActivity);
       if (timeDiff > (DEVICE_TIMEOUT >> 6)) {  // 除以64转换为相对时间单位
-        Serial.println(F("Device disconnected"));
+        LOG2(MSG_DEVICE_DISCONNECTED, devices[i].vid, devices[i].pid);
         devices[i].active = false;
         totalDevices--;
-
-        // 更新连接状态位标志
-        if (devices[i].deviceType == DEVICE_KEYBOARD) {
-          status.keyboardConnected = false;
-        } else if (devices[i].deviceType == DEVICE_MOUSE) {
-          status.mouseConnected = false;
-        }
       }
     }
   }
@@ -223,32 +275,29 @@ void HIDManager::updateChangeFlags(int8_t deviceIndex, uint8_t len, uint8_t *buf
   }
 }
 
-void HIDManager::printConnectedDevices() {
+void HIDManager::printConnectedDevices(uint8_t index) {
   if (totalDevices == 0) {
-    Serial.println(F("No device"));
+    LOG1(MSG_STATUS_NONE, index);
     return;
   }
 
   // 简化输出 - 每个实例只显示自己的设备
   for (uint8_t i = 0; i < MAX_DEVICES; i++) {
     if (devices[i].active) {
+      uint8_t id;
       switch (devices[i].deviceType) {
         case DEVICE_KEYBOARD:
-          Serial.print(F("Keyboard"));
+          id = MSG_STATUS_KEYBOARD;
           break;
         case DEVICE_MOUSE:
-          Serial.print(F("Mouse"));
+          id = MSG_STATUS_MOUSE;
           break;
         default:
-          Serial.print(F("Unknown"));
+          id = MSG_STATUS_UNKNOWN;
           break;
       }
 
-      Serial.print(F(" (VID:0x"));
-      Serial.print(devices[i].vid, HEX);
-      Serial.print(F(" PID:0x"));
-      Serial.print(devices[i].pid, HEX);
-      Serial.println(F(")"));
+      LOG3(id, index, devices[i].vid, devices[i].pid);
       return;  // 每个实例只有一个设备
     }
   }
@@ -4,12 +4,22 @@
 #include <hiduniversal.h>
 #include "KeyboardDevice.h"
 #include "MouseDevice.h"
+#include "Log.h"
+#include "HandlerPool.h"
 
 // 性能优化配置
 #define MAX_DEVICES 1
 #define USE_INTERRUPT 1  // 中断模式开关
 #define BUFFER_SIZE 8    // 统一缓冲区大小
 
+// 处理器池容量（所有HIDManager实例共享）
+// HID_INSTANCE_COUNT 需与草图中的 HIDManager 实例数（hid1/hid2）一致。
+// 缺省每个实例都可接键盘或鼠标（与内嵌处理器时相同）；
+// 已知设备组合时可减小对应池容量节省 SRAM，超出的设备报告 MSG_HANDLER_POOL_EMPTY 并被忽略。
+#define HID_INSTANCE_COUNT 2
+#define KEYBOARD_POOL_SIZE HID_INSTANCE_COUNT
+#define MOUSE_POOL_SIZE HID_INSTANCE_COUNT
+
 // 轮询频率配置 (毫秒)
 #define POLL_ACTIVE 1        // 设备活跃时轮询间隔
 #define POLL_IDLE 10         // 设备空闲时轮询间隔
@@ -45,6 +55,9 @@ public:
   // 初始化设备管理器
   void init();
 
+  // USB断开时归还处理器
+  uint8_t Release() override;
+
   // 检查是否已连接设备
   bool isConnected() {
     return HIDUniversal::isReady();
@@ -61,8 +74,8 @@ public:
     return totalDevices > 0;
   }
 
-  // 获取连接的设备信息
-  void printConnectedDevices();
+  // 获取连接的设备信息（index 为实例编号，用于状态日志）
+  void printConnectedDevices(uint8_t index);
 
   // 性能统计
   void printMemoryUsage();
@@ -82,7 +95,16 @@ private:
   bool hasDataChanged(int8_t deviceIndex, uint8_t len, uint8_t *buf);
   void updateChangeFlags(int8_t deviceIndex, uint8_t len, uint8_t *buf);
   inline uint16_t getRelativeTime() {
-    return (uint16_t)(millis() & 0xFFFF);
+    return (uint16_t)(millis() >> 6);  // 64ms为单位，约70分钟回绕
+  }
+
+  // 从共享池分配/归还设备处理器
+  void acquireHandler(DeviceType type);
+  void releaseHandlers();
+
+  // 该类型设备是否持有处理器
+  inline bool hasHandler(DeviceType type) {
+    return (type == DEVICE_KEYBOARD && keyboard != nullptr) || (type == DEVICE_MOUSE && mouse != nullptr);
   }
 
 
@@ -91,16 +113,9 @@ private:
   uint8_t totalDevices;
   int8_t currentDevice;
 
-  // 设备处理器（静态分配）
-  KeyboardDevice keyboard;  // 不再使用指针
-  MouseDevice mouse;        // 不再使用指针
-
-  // 连接状态位标志（节省内存）
-  struct {
-    bool keyboardConnected : 1;
-    bool mouseConnected : 1;
-    bool _reserved : 6;  // 保留位
-  } status;
+  // 设备处理器（识别设备后从共享池分配，未连接时为空）
+  KeyboardDevice *keyboard;
+  MouseDevice *mouse;
 };
 
 
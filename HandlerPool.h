@@ -0,0 +1,50 @@
+#ifndef __HANDLERPOOL_h__
+#define __HANDLERPOOL_h__
+
+#include <Arduino.h>
+
+// 设备处理器静态池 - 按类型分开，容量在编译期确定（最多 8 个）
+// 识别到设备时分配，断开时归还；T 需提供 reset()。
+template <class T, uint8_t N>
+class HandlerPool {
+  static_assert(N <= 8, "HandlerPool usedMask holds at most 8 slots");
+
+public:
+  HandlerPool() : usedMask(0) {}
+
+  // 分配一个处理器，池已满时返回 nullptr
+  T *acquire() {
+    for (uint8_t i = 0; i < N; i++) {
+      uint8_t bit = 1 << i;
+      if (!(usedMask & bit)) {
+        usedMask |= bit;
+        slots[i].reset();
+        return &slots[i];
+      }
+    }
+    return nullptr;
+  }
+
+  // 归还处理器
+  void release(T *handler) {
+    if (handler < slots || handler >= slots + N) return;
+    uint8_t index = handler - slots;
+    handler->reset();
+    usedMask &= ~(1 << index);
+  }
+
+  // 已分配数量
+  uint8_t used() {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < N; i++) {
+      if (usedMask & (1 << i)) count++;
+    }
+    return count;
+  }
+
+private:
+  T slots[N];
+  uint8_t usedMask;  // 位标志记录占用
+};
+
+#endif  //__HANDLERPOOL_h__
@@ -0,0 +1,104 @@
+#include "HostClock.h"
+#include "Log.h"
+
+uint32_t HostClock::refDevice = 0;
+uint32_t HostClock::refHost = 0;
+int32_t HostClock::skew = 0;
+int32_t HostClock::lastError = 0;
+uint16_t HostClock::syncCount = 0;
+uint32_t HostClock::eventStamp = 0;
+
+uint8_t HostClock::rxBuffer[11];
+uint8_t HostClock::rxIndex = 0;
+uint32_t HostClock::rxTime = 0;
+unsigned long HostClock::rxLastByte = 0;
+
+void HostClock::poll() {
+  while (Serial.available() > 0) {
+    uint8_t b = Serial.read();
+    unsigned long ms = millis();
+
+    // 帧中断超时，丢弃不完整的帧
+    if (rxIndex > 0 && ms - rxLastByte > SYNC_FRAME_TIMEOUT) {
+      rxIndex = 0;
+    }
+    rxLastByte = ms;
+
+    if (rxIndex == 0) {
+      if (b != SYNC_FRAME_START) continue;
+      rxTime = micros();  // 尽早记录接收时刻
+    }
+    rxBuffer[rxIndex++] = b;
+
+    if (rxIndex == 2 && b != 'P' && b != 'S') {
+      rxIndex = 0;
+      continue;
+    }
+
+    uint8_t frameLen = rxBuffer[1] == 'P' ? 3 : sizeof(rxBuffer);
+    if (rxIndex < 3 || rxIndex < frameLen) continue;
+
+    if (rxBuffer[1] == 'P') {
+      // 回复接收与发送时刻，主机据此计算往返延迟
+      LOG3(MSG_SYNC_PONG, rxBuffer[2], rxTime, (uint32_t)micros());
+    } else {
+      applySample(readU32(&rxBuffer[3]), readU32(&rxBuffer[7]));
+    }
+    rxIndex = 0;
+  }
+}
+
+uint32_t HostClock::now() {
+  return toHost(micros());
+}
+
+uint32_t HostClock::toHost(uint32_t deviceMicros) {
+  if (syncCount == 0) return deviceMicros;
+
+  int32_t dt = (int32_t)(deviceMicros - refDevice);
+  int32_t correction = (int32_t)(((int64_t)dt * skew) >> 24);
+  return refHost + dt + correction;
+}
+
+void HostClock::applySample(uint32_t deviceMicros, uint32_t hostMicros) {
+  if (syncCount == 0) {
+    refDevice = deviceMicros;
+    refHost = hostMicros;
+    skew = 0;
+    lastError = 0;
+    syncCount = 1;
+    return;
+  }
+
+  uint32_t predicted = toHost(deviceMicros);
+  int32_t error = (int32_t)(hostMicros - predicted);
+  int32_t elapsed = (int32_t)(deviceMicros - refDevice);
+
+  // 间隔足够长时按误差斜率修正频偏
+  if (elapsed > SYNC_SKEW_INTERVAL) {
+    int32_t measured = (int32_t)(((int64_t)error << 24) / elapsed);
+    skew += measured >> SYNC_SKEW_GAIN_SHIFT;
+    if (skew > SYNC_MAX_SKEW) skew = SYNC_MAX_SKEW;
+    if (skew < -SYNC_MAX_SKEW) skew = -SYNC_MAX_SKEW;
+  }
+
+  // 偏移直接对齐到样本：主机已按最小往返延迟筛选，
+  // 若只部分修正，残余偏移会在下一次被误算为频偏
+  refDevice = deviceMicros;
+  refHost = hostMicros;
+  lastError = error;
+  if (syncCount < 0xFFFF) syncCount++;
+}
+
+uint32_t HostClock::readU32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void HostClock::printStatus() {
+  // Q24 转换为 ppm：2^-24 * 10^6 = 15625 / 2^18
+  int16_t ppm = (int16_t)(((int64_t)skew * 15625) >> 18);
+  int32_t err = lastError;
+  if (err > 32767) err = 32767;
+  if (err < -32767) err = -32767;
+  LOG3(MSG_CLOCK_STATUS, syncCount, ppm, (int16_t)err);
+}
@@ -0,0 +1,70 @@
+#ifndef __HOSTCLOCK_h__
+#define __HOSTCLOCK_h__
+
+#include <Arduino.h>
+
+// 主机时钟同步配置
+#define USE_HOST_CLOCK 1
+#define SYNC_FRAME_START 0x16     // 主机 -> 设备帧头 (SYN)
+#define SYNC_FRAME_TIMEOUT 20     // 帧内字节间隔超时(ms)
+#define SYNC_SKEW_INTERVAL 1000000L  // 两次样本间隔超过该值(us)才估计频偏
+#define SYNC_SKEW_GAIN_SHIFT 1    // 频偏修正增益 1/2
+#define SYNC_MAX_SKEW 167772L     // 频偏上限 ±1% (Q24)
+
+// 主机帧格式：
+//   0x16 'P' seq                     请求时间戳，设备以 MSG_SYNC_PONG 回复接收/发送时刻
+//   0x16 'S' seq devRef(u32) hostRef(u32)  主机根据最佳往返样本下发的对应时刻
+// 时间均为 32 位微秒（小端），允许回绕。
+
+// 主机时钟模型 - NTP 式 ping/pong，定点偏移与频偏
+// host = refHost + dt + dt * skew / 2^24，其中 dt = micros() - refDevice
+class HostClock {
+public:
+  // 处理串口输入的同步帧（在 loop 中调用）
+  static void poll();
+
+  // 当前时刻的主机时间(us)
+  static uint32_t now();
+
+  // 记录当前报告的时间戳，本报告产生的所有事件共用
+  static inline void stamp() {
+    eventStamp = now();
+  }
+
+  // 当前事件的主机时间(us)
+  static inline uint32_t eventTime() {
+    return eventStamp;
+  }
+
+  // 是否已收到至少一个同步样本
+  static inline bool isSynced() {
+    return syncCount > 0;
+  }
+
+  // 输出同步状态
+  static void printStatus();
+
+private:
+  // 设备时间换算为主机时间
+  static uint32_t toHost(uint32_t deviceMicros);
+
+  // 用一对对应时刻更新偏移与频偏
+  static void applySample(uint32_t deviceMicros, uint32_t hostMicros);
+
+  static uint32_t readU32(const uint8_t *p);
+
+  static uint32_t refDevice;   // 参考点设备时间(us)
+  static uint32_t refHost;     // 参考点主机时间(us)
+  static int32_t skew;         // 频偏 (Q24，主机/设备 - 1)
+  static int32_t lastError;    // 最近样本相对模型的误差(us)
+  static uint16_t syncCount;
+  static uint32_t eventStamp;
+
+  // 接收状态
+  static uint8_t rxBuffer[11];
+  static uint8_t rxIndex;
+  static uint32_t rxTime;      // 帧头到达时刻（设备时间）
+  static unsigned long rxLastByte;
+};
+
+#endif  //__HOSTCLOCK_h__
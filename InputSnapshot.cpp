@@ -0,0 +1,4 @@
+#include "InputSnapshot.h"
+
+// 全局输入状态快照，由所有HIDManager实例更新
+InputSnapshot inputSnapshot;
@@ -0,0 +1,110 @@
+#ifndef __INPUTSNAPSHOT_h__
+#define __INPUTSNAPSHOT_h__
+
+// 不依赖 Arduino.h，便于在主机上编译验证
+#include <stdint.h>
+#include <string.h>
+
+#define USE_INPUT_SNAPSHOT 1
+
+// 输入状态快照（所有HIDManager实例共享）
+struct InputState {
+  uint8_t keys[32];   // 按 HID 用法码索引的按下位图
+  uint8_t modifiers;  // 修饰符位 (MOD_*)
+  uint8_t buttons;    // 鼠标按键位 (MOUSE_*_BUTTON)
+  int16_t x;          // 绝对坐标
+  int16_t y;
+  uint32_t sequence;  // 读取时的序列号（偶数），每次更新加 2
+
+  inline bool isKeyDown(uint8_t keyCode) const {
+    return (keys[keyCode >> 3] >> (keyCode & 7)) & 1;
+  }
+};
+
+// AVR 单核只需编译器屏障；主机多线程需要内存屏障
+#if defined(__AVR__)
+typedef uint8_t snapshot_seq_t;  // 单字节读写天然原子
+#define SNAPSHOT_BARRIER() __asm__ __volatile__("" ::: "memory")
+#define SNAPSHOT_LOAD(v) (*(volatile snapshot_seq_t *)&(v))
+#define SNAPSHOT_STORE(v, n) (*(volatile snapshot_seq_t *)&(v) = (n))
+#else
+typedef uint32_t snapshot_seq_t;
+#define SNAPSHOT_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define SNAPSHOT_LOAD(v) __atomic_load_n(&(v), __ATOMIC_ACQUIRE)
+#define SNAPSHOT_STORE(v, n) __atomic_store_n(&(v), (n), __ATOMIC_RELEASE)
+#endif
+
+// 输入状态快照 - 顺序锁 (seqlock)
+// 写者（USB 处理或中断，只能有一个）在 beginWrite/endWrite 之间更新，序列号为奇数表示正在写；
+// 读者复制整个状态，若序列号为奇数或前后不一致则重试，保证读到一致的快照。
+// 注意：在中断中读取时不能自旋等待被打断的写者，应使用 tryRead()。
+class InputSnapshot {
+public:
+  InputSnapshot() : seq(0) {
+    memset(&state, 0, sizeof(state));
+  }
+
+  // 写者接口
+  inline void beginWrite() {
+    SNAPSHOT_STORE(seq, (snapshot_seq_t)(seq + 1));
+    SNAPSHOT_BARRIER();
+  }
+
+  inline void endWrite() {
+    SNAPSHOT_BARRIER();
+    SNAPSHOT_STORE(seq, (snapshot_seq_t)(seq + 1));
+  }
+
+  inline void setKey(uint8_t keyCode, bool down) {
+    uint8_t mask = 1 << (keyCode & 7);
+    if (down) {
+      state.keys[keyCode >> 3] |= mask;
+    } else {
+      state.keys[keyCode >> 3] &= ~mask;
+    }
+  }
+
+  inline void setModifiers(uint8_t modifiers) {
+    state.modifiers = modifiers;
+  }
+
+  inline void setButtons(uint8_t buttons) {
+    state.buttons = buttons;
+  }
+
+  inline void setPosition(int16_t x, int16_t y) {
+    state.x = x;
+    state.y = y;
+  }
+
+  // 单次尝试读取，写入进行中或被打断时返回 false
+  inline bool tryRead(InputState &out) const {
+    snapshot_seq_t before = SNAPSHOT_LOAD(seq);
+    if (before & 1) return false;
+    SNAPSHOT_BARRIER();
+    memcpy(&out, (const void *)&state, sizeof(InputState));
+    SNAPSHOT_BARRIER();
+    if (SNAPSHOT_LOAD(seq) != before) return false;
+    out.sequence = before;
+    return true;
+  }
+
+  // 读取一致的快照（自旋重试）
+  inline void read(InputState &out) const {
+    while (!tryRead(out))
+      ;
+  }
+
+  // 当前序列号，可用于判断状态是否变化
+  inline snapshot_seq_t sequence() const {
+    return SNAPSHOT_LOAD(seq);
+  }
+
+private:
+  snapshot_seq_t seq;
+  InputState state;
+};
+
+extern InputSnapshot inputSnapshot;
+
+#endif  //__INPUTSNAPSHOT_h__
@@ -1,15 +1,22 @@
 #include <usbhub.h>
 #include <SPI.h>
 #include "HIDManager.h"
+#include "PowerManager.h"
+#include "MemoryMonitor.h"
+#include "HostClock.h"
 
 
 USB Usb;
 USBHub Hub(&Usb);
 
 // 只使用2个HID实例以节省内存 - 支持键盘+鼠标
+// 增减实例时同步修改 HIDManager.h 中的 HID_INSTANCE_COUNT（决定处理器池容量）
 HIDManager hid1(&Usb);
 HIDManager hid2(&Usb);
 
+// 低功耗空闲管理
+PowerManager power;
+
 // 中断辅助热插拔检测
 #if USE_INTERRUPT
 #define USB_INT_PIN 3  // 中断引脚 (Arduino Uno: Pin 3)
@@ -28,35 +35,45 @@ void setup() {
   // 配置中断引脚 (需要硬件连接: Arduino Pin 9 -> Pin 3)
   pinMode(USB_INT_PIN, INPUT_PULLUP);
   attachInterrupt(digitalPinToInterrupt(USB_INT_PIN), usbInterruptHandler, FALLING);
-  Serial.println(F("USB HID Manager - Interrupt Mode"));
+  LOG0(MSG_BOOT_INTERRUPT);
 #else
-  Serial.println(F("USB HID Manager - Polling Mode"));
+  LOG0(MSG_BOOT_POLLING);
 #endif
 
   if (Usb.Init() == -1) {
-    Serial.println(F("USB Host init failed"));
+    LOG0(MSG_USB_INIT_FAILED);
     while (1)
       ;
   }
 
-  Serial.println(F("Ready"));
+#if USE_INTERRUPT
+  // MAX3421E 初始化时开启了 SOF 帧中断，设备连接后 INT 每 1ms 触发一次，
+  // 低功耗空闲会被不断唤醒并进入保持期。只保留连接检测中断；
+  // 库内部轮询的 FRAMEIRQ 标志不受中断使能影响。
+  Usb.regWr(rHIEN, Usb.regRd(rHIEN) & ~bmFRAMEIE);
+#endif
+
+  LOG0(MSG_READY);
 
   // 初始化HID管理器实例
   hid1.init();
   hid2.init();
-}
 
-// 简化的内存检测函数（避免编译错误）
-int freeMemory() {
-  // 为了避免跨平台兼容性问题，暂时返回固定值
-  // 在实际部署时可以启用平台特定的内存检测
-  return 1500;  // 估计可用内存值
+  power.init();
 }
 
 void loop() {
   static unsigned long lastPoll = 0;
   static unsigned long lastStatusCheck = 0;
+  static uint32_t pollCount = 0;
+  static uint16_t forcedCount = 0;
   bool forceCheck = false;
+  MEM_PROBE(MEM_PATH_LOOP);
+
+#if USE_HOST_CLOCK
+  // 优先处理时钟同步帧，减少接收时刻误差
+  HostClock::poll();
+#endif
 
   unsigned long currentTime = millis();
 
@@ -72,7 +89,14 @@ void loop() {
   uint16_t pollInterval = max(hid1.getPollInterval(), hid2.getPollInterval());
 
   if (forceCheck || (currentTime - lastPoll >= pollInterval)) {
+#if USE_INTERRUPT
+    if (forceCheck) {
+      power.markServiced();  // 插拔中断：记录唤醒延迟并进入保持期
+      forcedCount++;
+    }
+#endif
     Usb.Task();
+    pollCount++;
     lastPoll = currentTime;
 
     // 检查HID实例的设备状态（降低频率或中断触发）
@@ -86,10 +110,31 @@ void loop() {
   // 简化的状态报告
   static unsigned long lastReport = 0;
   if (currentTime - lastReport > 30000) {  // 每30秒报告一次
-    Serial.print(F("Status - HID1: "));
-    hid1.printConnectedDevices();
-    Serial.print(F("HID2: "));
-    hid2.printConnectedDevices();
+    hid1.printConnectedDevices(1);
+    hid2.printConnectedDevices(2);
+    LOG3(MSG_POLL_STATS, pollCount, forcedCount, pollInterval);
+#if USE_MEMORY_MONITOR
+    MemoryMonitor::printReport();
+#endif
+#if USE_HOST_CLOCK
+    HostClock::printStatus();
+#endif
+#if USE_INTERRUPT && USE_LOW_POWER
+    power.printStats();
+#endif
     lastReport = currentTime;
   }
+
+#if USE_INTERRUPT && USE_LOW_POWER
+  // 无节拍空闲：睡眠到下一次调度轮询。HID 报告由定时轮询读取，
+  // USB INT 只在设备插拔时提前唤醒
+  unsigned long now = millis();
+  if (!power.inHoldoff(now)) {
+    pollInterval = max(hid1.getPollInterval(), hid2.getPollInterval());
+    unsigned long elapsed = now - lastPoll;
+    if (elapsed < pollInterval) {
+      power.sleepFor(pollInterval - elapsed, &usbInterruptFlag);
+    }
+  }
+#endif
 }
@@ -2,6 +2,7 @@
 #define __KEYBOARDDEVICE_h__
 
 #include <Arduino.h>
+#include "EventSink.h"
 
 // 键盘HID报告结构 (标准8字节格式)
 struct KeyboardReport {
@@ -33,6 +34,9 @@ public:
   // 解析键盘HID报告
   void parseKeyboardReport(uint8_t len, uint8_t* data);
 
+  // 从共享快照中撤销本设备按下的键（断开时调用）
+  void clearSnapshot();
+
   // 公共访问初始化状态
   bool initialized;
 
@@ -43,14 +47,8 @@ private:
   // 解析修饰符
   void parseModifiers(uint8_t currentMod, uint8_t previousMod);
 
-  // 输出按键事件
-  void printKeyEvent(uint8_t keyCode, bool pressed, uint8_t modifiers);
-
-  // 获取按键名称
-  const char* getKeyName(uint8_t keyCode);
-
-  // 获取修饰符字符串
-  String getModifierString(uint8_t modifiers);
+  // 更新共享输入状态快照
+  void updateSnapshot();
 
   // 当前和上一次的键盘报告
   KeyboardReport currentReport;
@@ -0,0 +1,126 @@
+#include "Log.h"
+#include "MemoryMonitor.h"
+
+#if USE_TOKEN_LOG
+
+void Log::begin(uint8_t id) {
+  MEM_PROBE(MEM_PATH_LOG);
+  Serial.write((uint8_t)LOG_FRAME_START);
+  Serial.write(id);
+}
+
+void Log::arg(uint8_t value) {
+  Serial.write(value);
+}
+
+void Log::arg(uint16_t value) {
+  Serial.write((uint8_t)(value & 0xFF));
+  Serial.write((uint8_t)(value >> 8));
+}
+
+void Log::arg(int16_t value) {
+  arg((uint16_t)value);
+}
+
+void Log::arg(uint32_t value) {
+  arg((uint16_t)(value & 0xFFFF));
+  arg((uint16_t)(value >> 16));
+}
+
+void Log::buf(const uint8_t *data, uint8_t len) {
+  Serial.write(len);
+  Serial.write(data, len);
+}
+
+void Log::end() {
+  // 帧长度由消息表决定，无需结束符
+}
+
+#else
+
+// 文本模式：格式表存放在 Flash 中
+#define LOG_STRING(id, fmt) static const char id##_fmt[] PROGMEM = fmt;
+LOG_MESSAGES(LOG_STRING)
+#undef LOG_STRING
+
+#define LOG_POINTER(id, fmt) id##_fmt,
+static const char *const logFormats[LOG_MESSAGE_COUNT] PROGMEM = {
+  LOG_MESSAGES(LOG_POINTER)
+};
+#undef LOG_POINTER
+
+const char *Log::cursor = nullptr;
+static char pendingType = 0;  // 当前等待的占位符类型
+
+char Log::printUntilPlaceholder() {
+  if (cursor == nullptr) return 0;
+
+  char c;
+  while ((c = pgm_read_byte(cursor)) != '\0') {
+    cursor++;
+    if (c != '{') {
+      Serial.print(c);
+      continue;
+    }
+
+    // 读取占位符类型，如 {x16} 返回 'x'
+    char type = pgm_read_byte(cursor);
+    while ((c = pgm_read_byte(cursor)) != '\0') {
+      cursor++;
+      if (c == '}') break;
+    }
+    return type;
+  }
+  return 0;
+}
+
+void Log::begin(uint8_t id) {
+  MEM_PROBE(MEM_PATH_LOG);
+  cursor = id < LOG_MESSAGE_COUNT ? (const char *)pgm_read_ptr(&logFormats[id]) : nullptr;
+  pendingType = printUntilPlaceholder();
+}
+
+void Log::arg(uint8_t value) {
+  arg((uint32_t)value);
+}
+
+void Log::arg(uint16_t value) {
+  arg((uint32_t)value);
+}
+
+void Log::arg(int16_t value) {
+  if (pendingType == 'i') {
+    Serial.print(value);
+    pendingType = printUntilPlaceholder();
+  } else {
+    arg((uint32_t)(uint16_t)value);
+  }
+}
+
+void Log::arg(uint32_t value) {
+  if (pendingType == 'x') {
+    Serial.print(value, HEX);
+  } else {
+    Serial.print(value);
+  }
+  pendingType = printUntilPlaceholder();
+}
+
+void Log::buf(const uint8_t *data, uint8_t len) {
+  for (uint8_t i = 0; i < len; i++) {
+    if (i > 0) Serial.print(' ');
+    if (data[i] < 0x10) Serial.print('0');
+    Serial.print(data[i], HEX);
+  }
+  pendingType = printUntilPlaceholder();
+}
+
+void Log::end() {
+  // 输出剩余的格式串
+  while (printUntilPlaceholder() != 0)
+    ;
+  Serial.println();
+  cursor = nullptr;
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef __LOG_h__
+#define __LOG_h__
+
+#include <Arduino.h>
+#include "LogMessages.h"
+
+// 日志模式：1 = 令牌化二进制帧（需主机 tools/logdecode 解码），0 = 文本输出
+#define USE_TOKEN_LOG 1
+
+// 令牌化诊断日志
+// 令牌模式下每条日志只发送帧头、消息编号与小端参数，格式字符串不进入固件；
+// 文本模式下从 Flash 中的格式表逐段输出，便于直接用串口监视器查看。
+// 参数类型必须与 LogMessages.h 中的占位符一致。
+class Log {
+public:
+  // 开始一条日志
+  static void begin(uint8_t id);
+
+  // 写入参数
+  static void arg(uint8_t value);
+  static void arg(uint16_t value);
+  static void arg(int16_t value);
+  static void arg(uint32_t value);
+  static void buf(const uint8_t *data, uint8_t len);
+
+  // 结束一条日志
+  static void end();
+
+private:
+#if !USE_TOKEN_LOG
+  // 输出格式串直到下一个占位符，返回占位符类型字符
+  static char printUntilPlaceholder();
+
+  static const char *cursor;  // 当前格式串位置 (PROGMEM)
+#endif
+};
+
+#define LOG0(id) \
+  do { \
+    Log::begin(id); \
+    Log::end(); \
+  } while (0)
+
+#define LOG1(id, a) \
+  do { \
+    Log::begin(id); \
+    Log::arg(a); \
+    Log::end(); \
+  } while (0)
+
+#define LOG2(id, a, b) \
+  do { \
+    Log::begin(id); \
+    Log::arg(a); \
+    Log::arg(b); \
+    Log::end(); \
+  } while (0)
+
+#define LOG3(id, a, b, c) \
+  do { \
+    Log::begin(id); \
+    Log::arg(a); \
+    Log::arg(b); \
+    Log::arg(c); \
+    Log::end(); \
+  } while (0)
+
+#define LOG4(id, a, b, c, d) \
+  do { \
+    Log::begin(id); \
+    Log::arg(a); \
+    Log::arg(b); \
+    Log::arg(c); \
+    Log::arg(d); \
+    Log::end(); \
+  } while (0)
+
+#endif  //__LOG_h__
@@ -0,0 +1,44 @@
+#ifndef __LOGMESSAGES_h__
+#define __LOGMESSAGES_h__
+
+// 日志消息表 - 固件与主机解码工具共用
+// 每条消息在编译期分配一个编号，固件只发送编号和二进制参数。
+// 占位符决定参数的编码：
+//   {u8} {u16} {u32} 无符号整数 (小端)
+//   {i16}            有符号 16 位整数
+//   {x16}            16 位整数，十六进制显示
+//   {buf}            1 字节长度 + 数据，十六进制显示（每条消息最多一个）
+// 只能在表末尾追加新消息，以保持已部署固件的编号不变。
+#define LOG_MESSAGES(LOG_MSG) \
+  LOG_MSG(MSG_BOOT_INTERRUPT, "USB HID Manager - Interrupt Mode") \
+  LOG_MSG(MSG_BOOT_POLLING, "USB HID Manager - Polling Mode") \
+  LOG_MSG(MSG_USB_INIT_FAILED, "USB Host init failed") \
+  LOG_MSG(MSG_READY, "Ready") \
+  LOG_MSG(MSG_KEYBOARD_DETECTED, "Keyboard detected (VID:0x{x16} PID:0x{x16})") \
+  LOG_MSG(MSG_MOUSE_DETECTED, "Mouse detected (VID:0x{x16} PID:0x{x16})") \
+  LOG_MSG(MSG_UNKNOWN_DEVICE, "Unknown device type with report length: {u8} (VID:0x{x16} PID:0x{x16})") \
+  LOG_MSG(MSG_FIRST_REPORT, "First report len={u8} data={buf}") \
+  LOG_MSG(MSG_DEVICE_DISCONNECTED, "Device disconnected (VID:0x{x16} PID:0x{x16})") \
+  LOG_MSG(MSG_STATUS_NONE, "Status - HID{u8}: No device") \
+  LOG_MSG(MSG_STATUS_KEYBOARD, "Status - HID{u8}: Keyboard (VID:0x{x16} PID:0x{x16})") \
+  LOG_MSG(MSG_STATUS_MOUSE, "Status - HID{u8}: Mouse (VID:0x{x16} PID:0x{x16})") \
+  LOG_MSG(MSG_STATUS_UNKNOWN, "Status - HID{u8}: Unknown (VID:0x{x16} PID:0x{x16})") \
+  LOG_MSG(MSG_POLL_STATS, "Poll: {u32} polls, {u16} forced by INT, interval {u16}ms") \
+  LOG_MSG(MSG_IDLE_STATS, "Idle: {u16}/1000 sleep, INT wakes: {u16}, wake latency: {u16}us (max {u16}us)") \
+  LOG_MSG(MSG_MEMORY_REPORT, "Memory: free {u16}, stack high water {u16} (headroom {u16}), heap free list {u16}, largest block {u16}, deepest path {u8} (SP 0x{x16})") \
+  LOG_MSG(MSG_SYNC_PONG, "Sync pong seq={u8} rx={u32} tx={u32}") \
+  LOG_MSG(MSG_CLOCK_STATUS, "Clock: {u16} syncs, skew {i16}ppm, last error {i16}us") \
+  LOG_MSG(MSG_HANDLER_POOL_EMPTY, "No free handler for device type {u8}")
+
+// 固件帧格式：LOG_FRAME_START, 消息编号, 参数...
+// 0x1E (记录分隔符) 不会出现在文本事件输出中
+#define LOG_FRAME_START 0x1E
+
+#define LOG_ENUM(id, fmt) id,
+enum LogMessageId {
+  LOG_MESSAGES(LOG_ENUM)
+  LOG_MESSAGE_COUNT
+};
+#undef LOG_ENUM
+
+#endif  //__LOGMESSAGES_h__
@@ -0,0 +1,126 @@
+#include "MemoryMonitor.h"
+#include "Log.h"
+
+uint16_t MemoryMonitor::lowestSP = 0xFFFF;
+uint8_t MemoryMonitor::deepestPath = MEM_PATH_LOOP;
+uint16_t MemoryMonitor::highestHeap = 0;
+
+#if USE_MEMORY_MONITOR && defined(__AVR__)
+
+// avr-libc 内存布局符号
+extern char __heap_start;
+extern size_t __malloc_margin;
+
+struct __freelist {
+  size_t sz;
+  struct __freelist *nx;
+};
+extern struct __freelist *__flp;
+
+// 启动时填充 .bss 之后的全部 SRAM
+// 位于 .init3 段：早于全局构造函数和 main，此时栈尚未使用
+void paintStack() __attribute__((naked, used, section(".init3")));
+void paintStack() {
+  __asm volatile(
+    "    ldi r30, lo8(__heap_start)\n"
+    "    ldi r31, hi8(__heap_start)\n"
+    "    ldi r24, %0\n"
+    "    ldi r25, hi8(__stack)\n"
+    "    rjmp 2f\n"
+    "1:  st Z+, r24\n"
+    "2:  cpi r30, lo8(__stack)\n"
+    "    cpc r31, r25\n"
+    "    brlo 1b\n"
+    "    breq 1b\n"
+    :
+    : "i"(STACK_PAINT_BYTE));
+}
+
+static char *heapTop() {
+  return __brkval != nullptr ? __brkval : &__heap_start;
+}
+
+// 扫描起点：堆曾经到达的最高位置。堆收缩后其下方残留旧数据而非填充图案
+static const uint8_t *scanStart() {
+  uint16_t top = (uint16_t)heapTop();
+  if (top > MemoryMonitor::highestHeap) MemoryMonitor::highestHeap = top;
+  return (const uint8_t *)MemoryMonitor::highestHeap;
+}
+
+#endif
+
+int16_t MemoryMonitor::freeMemory() {
+#if USE_MEMORY_MONITOR && defined(__AVR__)
+  char top;
+  return (int16_t)(&top - heapTop());
+#else
+  return 0;
+#endif
+}
+
+uint16_t MemoryMonitor::stackHeadroom() {
+#if USE_MEMORY_MONITOR && defined(__AVR__)
+  // 从最高堆顶向上扫描仍保留填充图案的字节
+  const uint8_t *p = scanStart();
+  const uint8_t *limit = (const uint8_t *)SP;
+  uint16_t count = 0;
+  while (p < limit && *p == STACK_PAINT_BYTE) {
+    p++;
+    count++;
+  }
+  return count;
+#else
+  return 0;
+#endif
+}
+
+uint16_t MemoryMonitor::stackHighWater() {
+#if USE_MEMORY_MONITOR && defined(__AVR__)
+  // 首个被改写的字节即栈到达的最低地址
+  uint16_t deepest = (uint16_t)scanStart() + stackHeadroom();
+  return RAMEND - deepest + 1;
+#else
+  return 0;
+#endif
+}
+
+uint16_t MemoryMonitor::heapFreeListBytes() {
+#if USE_MEMORY_MONITOR && defined(__AVR__)
+  uint16_t total = 0;
+  for (struct __freelist *fp = __flp; fp != nullptr; fp = fp->nx) {
+    total += fp->sz;
+  }
+  return total;
+#else
+  return 0;
+#endif
+}
+
+uint16_t MemoryMonitor::largestFreeBlock() {
+#if USE_MEMORY_MONITOR && defined(__AVR__)
+  uint16_t largest = 0;
+  for (struct __freelist *fp = __flp; fp != nullptr; fp = fp->nx) {
+    if (fp->sz > largest) largest = fp->sz;
+  }
+
+  // malloc 从堆顶扩展时需要给栈保留 __malloc_margin
+  int16_t gap = freeMemory() - (int16_t)__malloc_margin;
+  if (gap > (int16_t)largest) largest = gap;
+  return largest;
+#else
+  return 0;
+#endif
+}
+
+void MemoryMonitor::printReport() {
+  uint16_t headroom = stackHeadroom();
+  Log::begin(MSG_MEMORY_REPORT);
+  Log::arg((uint16_t)freeMemory());
+  Log::arg(stackHighWater());
+  Log::arg(headroom);
+  Log::arg(heapFreeListBytes());
+  Log::arg(largestFreeBlock());
+  Log::arg(deepestPath);
+  Log::arg(lowestSP);
+  Log::end();
+}
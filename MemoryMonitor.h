@@ -0,0 +1,65 @@
+#ifndef __MEMORYMONITOR_h__
+#define __MEMORYMONITOR_h__
+
+#include <Arduino.h>
+
+// SRAM 监测配置
+#define USE_MEMORY_MONITOR 1
+#define STACK_PAINT_BYTE 0xC5  // 启动时填充空闲栈区的图案
+
+// 调用路径探针编号
+enum MemoryPath {
+  MEM_PATH_LOOP = 0,        // loop() 顶层
+  MEM_PATH_PARSE_HID = 1,   // Usb.Task() -> ParseHIDData
+  MEM_PATH_KEYBOARD = 2,    // 键盘事件输出
+  MEM_PATH_MOUSE = 3,       // 鼠标事件输出
+  MEM_PATH_LOG = 4          // 日志输出
+};
+
+#if USE_MEMORY_MONITOR && defined(__AVR__)
+extern char *__brkval;  // avr-libc 当前堆顶
+#endif
+
+// SRAM 监测 - 栈高水位（填充图案扫描）与堆碎片
+// 探针只读取 SP 并与最低值比较，开销为几条指令，可在生产固件中保留。
+class MemoryMonitor {
+public:
+  // 当前栈与堆之间的空闲字节数
+  static int16_t freeMemory();
+
+  // 历史最高堆顶之上从未被栈使用的字节数（扫描填充图案）
+  static uint16_t stackHeadroom();
+
+  // 历史最大栈使用量（字节）
+  static uint16_t stackHighWater();
+
+  // 堆空闲链表中的字节总数与最大空闲块
+  static uint16_t heapFreeListBytes();
+  static uint16_t largestFreeBlock();
+
+  // 记录栈最深的路径与最高堆顶
+  static inline void probe(uint8_t path) {
+#if USE_MEMORY_MONITOR && defined(__AVR__)
+    uint16_t sp = SP;
+    if (sp < lowestSP) {
+      lowestSP = sp;
+      deepestPath = path;
+    }
+    uint16_t brk = (uint16_t)__brkval;
+    if (brk > highestHeap) highestHeap = brk;
+#else
+    (void)path;
+#endif
+  }
+
+  // 输出内存报告
+  static void printReport();
+
+  static uint16_t lowestSP;    // 探针观测到的最低 SP
+  static uint8_t deepestPath;  // 对应的路径编号
+  static uint16_t highestHeap; // 探针观测到的最高堆顶（free 后 __brkval 会回落）
+};
+
+#define MEM_PROBE(path) MemoryMonitor::probe(path)
+
+#endif  //__MEMORYMONITOR_h__
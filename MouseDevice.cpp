@@ -1,4 +1,5 @@
 #include "MouseDevice.h"
+#include "InputSnapshot.h"
 
 MouseDevice::MouseDevice() {
   initialized = false;
@@ -12,6 +13,9 @@ void MouseDevice::init() {
   initialized = true;
   absoluteX = 0;
   absoluteY = 0;
+#if USE_GESTURES
+  gesture.reset();
+#endif
 }
 
 void MouseDevice::reset() {
@@ -20,6 +24,9 @@ void MouseDevice::reset() {
   memset(&previousReport, 0, sizeof(MouseReport));
   absoluteX = 0;
   absoluteY = 0;
+#if USE_GESTURES
+  gesture.reset();
+#endif
 }
 
 void MouseDevice::parseMouseReport(uint8_t len, uint8_t* data) {
@@ -39,96 +46,113 @@ void MouseDevice::parseMouseReport(uint8_t len, uint8_t* data) {
     currentReport.wheel = 0;
   }
 
-  // 检测并输出变化
+  // 检测并输出变化（笔势先处理，决定笔势按键与本次移动的去向）
+#if USE_GESTURES
+  detectGesture();
+#endif
   detectButtonChanges();
   detectMovement();
   detectWheelMovement();
+
+#if USE_INPUT_SNAPSHOT
+  // 更新共享输入状态快照（写区间不包含串口输出）
+  inputSnapshot.beginWrite();
+  inputSnapshot.setButtons(currentReport.buttons);
+  inputSnapshot.setPosition(absoluteX, absoluteY);
+  inputSnapshot.endWrite();
+#endif
 }
 
 void MouseDevice::detectButtonChanges() {
+  if (!(ActiveSink::events & EVENT_BUTTON)) return;
+
   uint8_t changedButtons = currentReport.buttons ^ previousReport.buttons;
 
+#if USE_GESTURES
+  // 笔势按键由 detectGesture() 处理
+  if (ActiveSink::events & EVENT_GESTURE) changedButtons &= ~GESTURE_BUTTON;
+#endif
+
   // 检测左键变化
   if (changedButtons & MOUSE_LEFT_BUTTON) {
     bool pressed = (currentReport.buttons & MOUSE_LEFT_BUTTON) != 0;
-    printButtonEvent(MOUSE_LEFT_BUTTON, pressed);
+    ActiveSink::onButton(MOUSE_LEFT_BUTTON, pressed);
   }
 
   // 检测右键变化
   if (changedButtons & MOUSE_RIGHT_BUTTON) {
     bool pressed = (currentReport.buttons & MOUSE_RIGHT_BUTTON) != 0;
-    printButtonEvent(MOUSE_RIGHT_BUTTON, pressed);
+    ActiveSink::onButton(MOUSE_RIGHT_BUTTON, pressed);
   }
 
   // 检测中键变化
   if (changedButtons & MOUSE_MIDDLE_BUTTON) {
     bool pressed = (currentReport.buttons & MOUSE_MIDDLE_BUTTON) != 0;
-    printButtonEvent(MOUSE_MIDDLE_BUTTON, pressed);
+    ActiveSink::onButton(MOUSE_MIDDLE_BUTTON, pressed);
   }
 }
 
 void MouseDevice::detectMovement() {
   // 检测鼠标移动
   if (currentReport.x != 0 || currentReport.y != 0) {
-    // 更新绝对坐标
-    absoluteX += currentReport.x;
-    absoluteY += currentReport.y;
-
-    // 防止坐标溢出
-    if (absoluteX < -32767) absoluteX = -32767;
-    if (absoluteX > 32767) absoluteX = 32767;
-    if (absoluteY < -32767) absoluteY = -32767;
-    if (absoluteY > 32767) absoluteY = 32767;
-
-    printMoveEvent(absoluteX, absoluteY);
+#if USE_GESTURES
+    // 笔势期间移动量送入识别器
+    if (gesture.isActive()) {
+      gesture.addMotion(currentReport.x, currentReport.y);
+#if GESTURE_SUPPRESS_MOTION
+      // 不计入绝对坐标，否则笔势结束后的首次移动会跳变
+      return;
+#endif
+    }
+#endif
+
+    // 更新绝对坐标（先用 32 位计算，防止坐标溢出）
+    int32_t newX = (int32_t)absoluteX + currentReport.x;
+    int32_t newY = (int32_t)absoluteY + currentReport.y;
+    if (newX < -32767) newX = -32767;
+    if (newX > 32767) newX = 32767;
+    if (newY < -32767) newY = -32767;
+    if (newY > 32767) newY = 32767;
+    absoluteX = (int16_t)newX;
+    absoluteY = (int16_t)newY;
+
+    if (ActiveSink::events & EVENT_MOTION) {
+      ActiveSink::onMotion(currentReport.x, currentReport.y, absoluteX, absoluteY);
+    }
   }
 }
 
 void MouseDevice::detectWheelMovement() {
   // 检测滚轮滚动
-  if (currentReport.wheel != 0) {
-    printWheelEvent(currentReport.wheel);
+  if ((ActiveSink::events & EVENT_WHEEL) && currentReport.wheel != 0) {
+    ActiveSink::onWheel(currentReport.wheel);
   }
 }
 
-void MouseDevice::printButtonEvent(uint8_t button, bool pressed) {
-  Serial.print(F("Mouse: "));
-  Serial.print(getButtonName(button));
-  Serial.print(F(" button "));
-  Serial.println(pressed ? F("pressed") : F("released"));
-}
+#if USE_GESTURES
+void MouseDevice::detectGesture() {
+  if (!(ActiveSink::events & EVENT_GESTURE)) return;
 
-void MouseDevice::printMoveEvent(int16_t x, int16_t y) {
-  Serial.print(F("Mouse: Moved to ("));
-  Serial.print(x);
-  Serial.print(F(", "));
-  Serial.print(y);
-  Serial.println(F(")"));
-}
+  uint8_t changedButtons = currentReport.buttons ^ previousReport.buttons;
+  if (!(changedButtons & GESTURE_BUTTON)) return;
 
-void MouseDevice::printWheelEvent(int8_t wheel) {
-  Serial.print(F("Mouse: Wheel "));
-  if (wheel > 0) {
-    Serial.print(F("up "));
-    Serial.println(wheel);
-  } else {
-    Serial.print(F("down "));
-    Serial.println(-wheel);
+  if (currentReport.buttons & GESTURE_BUTTON) {
+    // 按下事件暂缓，笔画结束后再决定是否补发
+    gesture.begin();
+    return;
   }
-}
 
-const char* MouseDevice::getButtonName(uint8_t button) {
-  switch (button) {
-    case MOUSE_LEFT_BUTTON:
-      return "Left";
-    case MOUSE_RIGHT_BUTTON:
-      return "Right";
-    case MOUSE_MIDDLE_BUTTON:
-      return "Middle";
-    default:
-      return "Unknown";
+  uint8_t id = gesture.end();
+  if (id != GESTURE_NONE) {
+    // 识别为笔势：丢弃按键事件，避免主机弹出右键菜单
+    ActiveSink::onGesture(id);
+  } else if (ActiveSink::events & EVENT_BUTTON) {
+    // 未识别：补发普通单击
+    ActiveSink::onButton(GESTURE_BUTTON, true);
+    ActiveSink::onButton(GESTURE_BUTTON, false);
   }
 }
+#endif
 
 void MouseDevice::getCurrentPosition(int16_t* x, int16_t* y) {
   if (x) *x = absoluteX;
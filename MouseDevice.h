@@ -2,6 +2,8 @@
 #define __MOUSEDEVICE_h__
 
 #include <Arduino.h>
+#include "EventSink.h"
+#include "GestureRecognizer.h"
 
 // 鼠标HID报告结构 (标准4字节格式)
 struct MouseReport {
@@ -29,7 +31,7 @@ public:
   // 解析鼠标HID报告
   void parseMouseReport(uint8_t len, uint8_t* data);
 
-  // 获取当前绝对坐标
+  // 获取当前绝对坐标（仅限主循环；其他上下文请读取 inputSnapshot）
   void getCurrentPosition(int16_t* x, int16_t* y);
 
   // 公共访问初始化状态
@@ -45,17 +47,13 @@ private:
   // 检测滚轮滚动
   void detectWheelMovement();
 
-  // 输出鼠标按键事件
-  void printButtonEvent(uint8_t button, bool pressed);
+#if USE_GESTURES
+  // 检测笔势按键按下/抬起；笔画期间暂缓该按键事件，未识别时补发单击
+  void detectGesture();
 
-  // 输出鼠标移动事件
-  void printMoveEvent(int16_t x, int16_t y);
-
-  // 输出滚轮事件
-  void printWheelEvent(int8_t wheel);
-
-  // 获取按键名称
-  const char* getButtonName(uint8_t button);
+  // 笔势识别器
+  GestureRecognizer gesture;
+#endif
 
   // 当前和上一次的鼠标报告
   MouseReport currentReport;
@@ -0,0 +1,216 @@
+#include "PowerManager.h"
+#include "Log.h"
+
+#if USE_LOW_POWER && defined(__AVR__)
+#include <avr/sleep.h>
+#include <avr/power.h>
+
+// Arduino 核心(wiring.c)中的计时变量，睡眠后用于补偿
+extern volatile unsigned long timer0_millis;
+extern volatile unsigned long timer0_overflow_count;
+
+// Timer2 以 1024 分频计数：16MHz 时每 tick 64us，250 tick 正好 16ms
+#define T2_TICK_US (1024000000UL / F_CPU)
+#define T2_MAX_TICKS 250
+#define T2_MIN_TICKS 4  // 剩余不足该值时不再设置新的比较值
+#define T0_TICK_US clockCyclesToMicroseconds(64)
+#define T0_OVERFLOW_US clockCyclesToMicroseconds(64 * 256)
+
+static volatile bool timer2Expired = false;
+
+ISR(TIMER2_COMPA_vect) {
+  timer2Expired = true;
+}
+
+// 当前分段开始前已累计的 tick 加上本分段已走过的 tick（需在关中断时调用）
+// 已到期但主循环尚未累加的分段也计入
+static uint32_t timer2Elapsed(uint32_t counted, uint8_t chunk) {
+  uint8_t t = TCNT2;
+  if (timer2Expired || ((TIFR2 & _BV(OCF2A)) && t < chunk / 2)) counted += chunk;
+  return counted + t;
+}
+#endif
+
+PowerManager::PowerManager()
+  : sleepMillis(0),
+    interruptWakes(0),
+    lastWakeLatency(0),
+    maxWakeLatency(0),
+    lastServiced(0),
+    wakeMicros(0),
+    wakePending(false),
+    millisRemainder(0) {
+}
+
+void PowerManager::init() {
+#if USE_LOW_POWER && defined(__AVR__)
+  // 关闭未使用的外设以降低空闲电流
+  ADCSRA &= ~_BV(ADEN);
+  power_adc_disable();
+  power_twi_disable();
+#endif
+}
+
+uint16_t PowerManager::sleepFor(uint16_t ms, volatile bool *wakeFlag) {
+#if USE_LOW_POWER && defined(__AVR__)
+  if (ms < SLEEP_MIN_INTERVAL || *wakeFlag) return 0;
+
+  uint32_t remainingTicks = ((uint32_t)ms * 1000UL) / T2_TICK_US;
+  uint32_t elapsedTicks = 0;
+  uint32_t wakeTicks = 0;  // INT 唤醒时 Timer2 已计的 tick
+  uint8_t wakeT0 = 0;      // INT 唤醒时的 TCNT0
+  bool interrupted = false;
+
+  // 保存 Timer2 的 PWM 配置，结束后恢复
+  uint8_t savedTCCR2A = TCCR2A;
+  uint8_t savedTCCR2B = TCCR2B;
+
+  // 关闭 Timer0 溢出中断：睡眠期间不再每毫秒唤醒。
+  // 记录此刻的 TCNT0 相位，已置位但未处理的溢出按 micros() 的规则计入
+  cli();
+  unsigned long entryMicros = micros();
+  TIMSK0 &= ~_BV(TOIE0);
+  uint8_t startT0 = TCNT0;
+  uint8_t pendingOverflows = ((TIFR0 & _BV(TOV0)) && startT0 < 255) ? 1 : 0;
+  sei();
+
+  // Timer2 CTC 模式，分段定时
+  uint8_t chunk = remainingTicks > T2_MAX_TICKS ? T2_MAX_TICKS : (uint8_t)remainingTicks;
+  TCCR2B = 0;
+  TCCR2A = _BV(WGM21);
+  TCNT2 = 0;
+  OCR2A = chunk - 1;
+  TIFR2 = _BV(OCF2A);
+  timer2Expired = false;
+  TIMSK2 = _BV(OCIE2A);
+  TCCR2B = _BV(CS22) | _BV(CS21) | _BV(CS20);
+
+  set_sleep_mode(SLEEP_MODE_IDLE);
+
+  while (true) {
+    cli();
+    if (*wakeFlag) {
+      if (!interrupted) {
+        wakeT0 = TCNT0;
+        wakeTicks = timer2Elapsed(elapsedTicks, chunk);
+        interrupted = true;
+      }
+      break;
+    }
+    // 串口收到数据（如时钟同步帧）时提前结束睡眠，尽快处理
+    if (Serial.available() > 0) {
+      break;
+    }
+    if (!timer2Expired) {
+      sleep_enable();
+      sei();  // sei 后的下一条指令保证执行，不会丢失唤醒
+      sleep_cpu();
+      sleep_disable();
+
+      // 唤醒后立即记录时刻（此时唤醒中断已执行），用于统计唤醒延迟
+      if (*wakeFlag && !interrupted) {
+        cli();
+        wakeT0 = TCNT0;
+        wakeTicks = timer2Elapsed(elapsedTicks, chunk);
+        sei();
+        interrupted = true;
+      }
+    } else {
+      sei();
+    }
+
+    // 被串口等其他中断唤醒时继续睡眠
+    if (timer2Expired) {
+      timer2Expired = false;
+      elapsedTicks += chunk;
+      remainingTicks -= chunk;
+      if (remainingTicks < T2_MIN_TICKS) break;
+      chunk = remainingTicks > T2_MAX_TICKS ? T2_MAX_TICKS : (uint8_t)remainingTicks;
+      OCR2A = chunk - 1;
+    }
+  }
+
+  // 循环退出时中断保持关闭，直到计时补偿完成
+  cli();
+  elapsedTicks = timer2Elapsed(elapsedTicks, chunk);
+
+  // 恢复 Timer2
+  TCCR2B = 0;
+  TIMSK2 = 0;
+  TIFR2 = _BV(OCF2A);
+  TCCR2A = savedTCCR2A;
+  TCCR2B = savedTCCR2B;
+
+  // 由 TCNT0 相位还原睡眠期间的实际溢出次数：先清除溢出标志再读取 TCNT0，
+  // 若读取前又发生溢出（TCNT0 已回绕），该次已包含在相位中，再清一次标志
+  TIFR0 = _BV(TOV0);
+  uint8_t endT0 = TCNT0;
+  if ((TIFR0 & _BV(TOV0)) && endT0 < 255) TIFR0 = _BV(TOV0);
+
+  uint32_t t0Ticks = timer0Ticks(startT0, endT0, elapsedTicks * (T2_TICK_US / T0_TICK_US));
+  compensateClock(timer0Overflows(startT0, t0Ticks) + pendingOverflows);
+  TIMSK0 |= _BV(TOIE0);
+  sei();
+
+  uint16_t slept = (uint16_t)(t0Ticks * T0_TICK_US / 1000);
+  sleepMillis += slept;
+
+  if (interrupted) {
+    // 唤醒时刻 = 进入时刻 + 唤醒前经过的 Timer0 时长
+    interruptWakes++;
+    wakeMicros = entryMicros + timer0Ticks(startT0, wakeT0, wakeTicks * (T2_TICK_US / T0_TICK_US)) * T0_TICK_US;
+    wakePending = true;
+  }
+  return slept;
+#else
+  (void)ms;
+  (void)wakeFlag;
+  return 0;
+#endif
+}
+
+void PowerManager::compensateClock(uint32_t overflows) {
+#if USE_LOW_POWER && defined(__AVR__)
+  uint8_t oldSREG = SREG;
+  cli();
+
+  // micros() = (溢出计数 << 8) + TCNT0，溢出计数必须与 TCNT0 相位一致
+  timer0_overflow_count += overflows;
+
+  // millis() 按每次溢出 1024us 累加，与 Timer0 中断的步进一致
+  uint32_t total = overflows * T0_OVERFLOW_US + millisRemainder;
+  timer0_millis += total / 1000;
+  millisRemainder = total % 1000;
+
+  SREG = oldSREG;
+#else
+  (void)overflows;
+#endif
+}
+
+void PowerManager::markServiced() {
+  lastServiced = millis();
+
+  if (wakePending) {
+    wakePending = false;
+    unsigned long latency = micros() - wakeMicros;
+    lastWakeLatency = latency > 0xFFFF ? 0xFFFF : (uint16_t)latency;
+    if (lastWakeLatency > maxWakeLatency) {
+      maxWakeLatency = lastWakeLatency;
+    }
+  }
+}
+
+uint16_t PowerManager::getResidencyPermille() {
+  unsigned long uptime = millis();
+  if (uptime == 0) return 0;
+  // 避免 32 位溢出：运行较久后按秒计算
+  if (uptime > 1000000UL) {
+    return (uint16_t)(sleepMillis / (uptime / 1000));
+  }
+  return (uint16_t)((sleepMillis * 1000) / uptime);
+}
+
+void PowerManager::printStats() {
+  LOG4(MSG_IDLE_STATS, getResidencyPermille(), interruptWakes, lastWakeLatency, maxWakeLatency);
+}
@@ -0,0 +1,72 @@
+#ifndef __POWERMANAGER_h__
+#define __POWERMANAGER_h__
+
+#include <Arduino.h>
+
+// 低功耗空闲配置
+#define USE_LOW_POWER 1        // 低功耗空闲开关（需要 USE_INTERRUPT 唤醒）
+#define SLEEP_MIN_INTERVAL 2   // 小于该间隔(ms)不进入睡眠，直接忙等
+#define WAKE_HOLDOFF 20        // 插拔中断后保持清醒的时间(ms)，加快枚举
+
+// 低功耗空闲管理器
+// AVR 上使用 SLEEP_MODE_IDLE + Timer2 定时唤醒，睡眠期间关闭 Timer0 溢出中断（无节拍）。
+// Timer0 在 IDLE 模式下继续计数，唤醒后由进入/退出时的 TCNT0 相位和 Timer2 粗略时长
+// 还原实际溢出次数，使 millis()/micros() 保持连续。
+// USB INT 只在设备插拔时触发（SOF 中断已屏蔽），HID 报告仍由定时轮询读取；
+// 串口中断也可提前唤醒。
+class PowerManager {
+public:
+  PowerManager();
+
+  // 由 TCNT0 相位还原实际经过的 Timer0 tick 数（纯整数运算，可在主机上验证）
+  // start/end 为进入/退出时的 TCNT0，estimatedTicks 为 Timer2 估计的时长，
+  // 估计误差需小于半个溢出周期（128 tick）
+  static inline uint32_t timer0Ticks(uint8_t start, uint8_t end, uint32_t estimatedTicks) {
+    uint8_t phase = end - start;
+    if (estimatedTicks + 128 <= phase) return phase;
+    uint32_t periods = (estimatedTicks + 128 - phase) >> 8;
+    return (periods << 8) + phase;
+  }
+
+  // 经过 ticks 个 Timer0 tick 后发生的溢出次数
+  static inline uint32_t timer0Overflows(uint8_t start, uint32_t ticks) {
+    return (start + ticks) >> 8;
+  }
+
+  // 初始化（关闭未使用的外设）
+  void init();
+
+  // 睡眠最多 ms 毫秒；wakeFlag 被置位时立即返回。返回实际睡眠时间(ms)
+  uint16_t sleepFor(uint16_t ms, volatile bool *wakeFlag);
+
+  // 标记中断触发的 USB 处理（设备插拔）：开始保持期，并统计从唤醒到处理的延迟
+  void markServiced();
+
+  // 中断触发处理后的保持期内不应再次睡眠
+  bool inHoldoff(unsigned long now) {
+    return (now - lastServiced) < WAKE_HOLDOFF;
+  }
+
+  // 睡眠占空比（千分比）
+  uint16_t getResidencyPermille();
+
+  // 统计输出
+  void printStats();
+
+  // 统计信息
+  uint32_t sleepMillis;         // 累计睡眠时间(ms)
+  uint16_t interruptWakes;      // 被 USB INT 提前唤醒次数
+  uint16_t lastWakeLatency;     // 最近一次 INT 唤醒到处理的延迟(us)
+  uint16_t maxWakeLatency;      // 最大唤醒延迟(us)
+
+private:
+  // 将睡眠期间发生的 Timer0 溢出补偿到 Arduino 计时器
+  void compensateClock(uint32_t overflows);
+
+  unsigned long lastServiced;   // 最近一次中断触发的处理时刻
+  unsigned long wakeMicros;     // 最近一次中断唤醒时刻
+  bool wakePending : 1;         // 等待首次处理以记录延迟
+  uint16_t millisRemainder;     // 补偿 millis 的亚毫秒余数(us)
+};
+
+#endif  //__POWERMANAGER_h__
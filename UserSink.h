@@ -0,0 +1,15 @@
+#ifndef __USERSINK_h__
+#define __USERSINK_h__
+
+// 自定义事件接收器 - 只能由 EventSink.h 包含（位于 ActiveSink 选择之前）
+// Arduino 分别编译各 .cpp，在 .ino 中 #define EVENT_SINK 不会影响设备类；
+// 自定义接收器和 EVENT_SINK 选择都写在本文件，所有编译单元才能看到同一个 ActiveSink。
+//
+// 示例：只关心鼠标点击，同时保留串口文本输出
+//   struct ClickSink : EventSinkBase {
+//     static const uint8_t events = EVENT_BUTTON;
+//     static inline void onButton(uint8_t button, bool pressed) { ... }
+//   };
+//   #define EVENT_SINK EventSinkPair<ClickSink, SerialTextSink>
+
+#endif  //__USERSINK_h__
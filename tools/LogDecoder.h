@@ -0,0 +1,220 @@
+#ifndef __LOGDECODER_h__
+#define __LOGDECODER_h__
+
+// 主机端令牌化日志解码器（C++11，无 Arduino 依赖）
+// 字符串表由固件同一份 LogMessages.h 生成，编号与固件严格一致。
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "../LogMessages.h"
+
+// 参数类型
+enum LogArgType {
+  LOG_ARG_U8,
+  LOG_ARG_U16,
+  LOG_ARG_I16,
+  LOG_ARG_X16,
+  LOG_ARG_U32,
+  LOG_ARG_BUF
+};
+
+struct LogMessageInfo {
+  const char *name;
+  const char *format;
+};
+
+#define LOG_TABLE_ENTRY(id, fmt) { #id, fmt },
+static const LogMessageInfo logMessageTable[LOG_MESSAGE_COUNT] = {
+  LOG_MESSAGES(LOG_TABLE_ENTRY)
+};
+#undef LOG_TABLE_ENTRY
+
+// 解码结果：一行文本输出，或一条完整的日志帧
+struct LogRecord {
+  bool isLog;
+  uint8_t id;
+  std::vector<uint32_t> args;  // 整数参数（按出现顺序）
+  std::vector<uint8_t> blob;   // {buf} 参数
+  std::string text;            // 文本行或格式化后的日志
+};
+
+class LogDecoder {
+public:
+  LogDecoder() : state(STATE_TEXT), id(0), argIndex(0), byteIndex(0), value(0), blobLen(0) {
+    for (uint8_t i = 0; i < LOG_MESSAGE_COUNT; i++) {
+      argTypes[i] = parseArgTypes(logMessageTable[i].format);
+    }
+  }
+
+  // 送入一个字节；产生完整记录时返回 true
+  bool feed(uint8_t byte, LogRecord &out) {
+    switch (state) {
+      case STATE_TEXT:
+        if (byte == LOG_FRAME_START) {
+          state = STATE_ID;
+          return false;
+        }
+        if (byte == '\n') {
+          out.isLog = false;
+          out.id = 0;
+          out.args.clear();
+          out.blob.clear();
+          out.text.swap(line);
+          line.clear();
+          return true;
+        }
+        if (byte != '\r') line.push_back((char)byte);
+        return false;
+
+      case STATE_ID:
+        if (byte >= LOG_MESSAGE_COUNT) {
+          // 未知编号：固件与解码器版本不一致，回到文本模式
+          state = STATE_TEXT;
+          return false;
+        }
+        id = byte;
+        record.isLog = true;
+        record.id = id;
+        record.args.clear();
+        record.blob.clear();
+        argIndex = 0;
+        return startArg(out);
+
+      case STATE_ARG: {
+        LogArgType type = argTypes[id][argIndex];
+        if (type == LOG_ARG_BUF) {
+          if (blobLen == 0xFFFF) {
+            blobLen = byte;
+            if (blobLen == 0) return nextArg(out);
+            return false;
+          }
+          record.blob.push_back(byte);
+          if (record.blob.size() == blobLen) return nextArg(out);
+          return false;
+        }
+        value |= (uint32_t)byte << (8 * byteIndex);
+        byteIndex++;
+        if (byteIndex == argSize(type)) {
+          if (type == LOG_ARG_I16) value = (uint32_t)(int32_t)(int16_t)value;
+          record.args.push_back(value);
+          return nextArg(out);
+        }
+        return false;
+      }
+    }
+    return false;
+  }
+
+  // 按格式串渲染日志
+  static std::string format(const LogRecord &rec) {
+    if (rec.id >= LOG_MESSAGE_COUNT) return std::string();
+
+    std::string result;
+    const char *p = logMessageTable[rec.id].format;
+    size_t argIndex = 0;
+    char tmp[16];
+
+    while (*p) {
+      if (*p != '{') {
+        result.push_back(*p++);
+        continue;
+      }
+      const char *close = p;
+      while (*close && *close != '}') close++;
+      LogArgType type = typeFromName(std::string(p + 1, close));
+      p = *close ? close + 1 : close;
+
+      if (type == LOG_ARG_BUF) {
+        for (size_t i = 0; i < rec.blob.size(); i++) {
+          snprintf(tmp, sizeof(tmp), i ? " %02X" : "%02X", rec.blob[i]);
+          result += tmp;
+        }
+        continue;
+      }
+
+      uint32_t v = argIndex < rec.args.size() ? rec.args[argIndex] : 0;
+      argIndex++;
+      if (type == LOG_ARG_X16) {
+        snprintf(tmp, sizeof(tmp), "%X", (unsigned)v);
+      } else if (type == LOG_ARG_I16) {
+        snprintf(tmp, sizeof(tmp), "%d", (int)(int32_t)v);
+      } else {
+        snprintf(tmp, sizeof(tmp), "%u", (unsigned)v);
+      }
+      result += tmp;
+    }
+    return result;
+  }
+
+  static LogArgType typeFromName(const std::string &name) {
+    if (name == "u8") return LOG_ARG_U8;
+    if (name == "u16") return LOG_ARG_U16;
+    if (name == "i16") return LOG_ARG_I16;
+    if (name == "x16") return LOG_ARG_X16;
+    if (name == "u32") return LOG_ARG_U32;
+    return LOG_ARG_BUF;
+  }
+
+private:
+  enum State {
+    STATE_TEXT,
+    STATE_ID,
+    STATE_ARG
+  };
+
+  static uint8_t argSize(LogArgType type) {
+    switch (type) {
+      case LOG_ARG_U8: return 1;
+      case LOG_ARG_U32: return 4;
+      default: return 2;
+    }
+  }
+
+  static std::vector<LogArgType> parseArgTypes(const char *fmt) {
+    std::vector<LogArgType> types;
+    for (const char *p = fmt; *p; p++) {
+      if (*p != '{') continue;
+      const char *close = p;
+      while (*close && *close != '}') close++;
+      types.push_back(typeFromName(std::string(p + 1, close)));
+      if (!*close) break;
+      p = close;
+    }
+    return types;
+  }
+
+  // 准备读取下一个参数；没有参数时日志完成
+  bool startArg(LogRecord &out) {
+    if (argIndex >= argTypes[id].size()) {
+      record.text = format(record);
+      out = record;
+      state = STATE_TEXT;
+      return true;
+    }
+    value = 0;
+    byteIndex = 0;
+    blobLen = 0xFFFF;
+    state = STATE_ARG;
+    return false;
+  }
+
+  bool nextArg(LogRecord &out) {
+    argIndex++;
+    return startArg(out);
+  }
+
+  State state;
+  uint8_t id;
+  size_t argIndex;
+  uint8_t byteIndex;
+  uint32_t value;
+  uint16_t blobLen;
+  std::string line;
+  LogRecord record;
+  std::vector<LogArgType> argTypes[LOG_MESSAGE_COUNT];
+};
+
+#endif  //__LOGDECODER_h__
@@ -0,0 +1,95 @@
+// 鼠标笔势识别 (GestureRecognizer) 主机测试
+// 编译: g++ -std=c++11 -O2 -Ihoststub -o gesture_test gesture_test.cpp ../GestureRecognizer.cpp
+// 用法: gesture_test
+// 按方向序列生成相对移动报告送入识别器，检查各模板能被识别、
+// 有歧义或不匹配任何模板的笔画返回 GESTURE_NONE。
+
+#include <stdio.h>
+
+#include "../GestureRecognizer.h"
+
+#define REPORTS_PER_SEGMENT 3  // 每段发送的报告数（需不少于 GESTURE_CONFIRM）
+
+struct StrokeCase {
+  const char *name;
+  uint8_t expected;
+  uint8_t length;
+  uint8_t dirs[4];
+};
+
+// 与 GestureRecognizer.cpp 中的模板顺序一致
+static const StrokeCase cases[] = {
+  // 模板本身
+  { "Right", 0, 1, { DIR_RIGHT } },
+  { "Left", 1, 1, { DIR_LEFT } },
+  { "Up", 2, 1, { DIR_UP } },
+  { "Down", 3, 1, { DIR_DOWN } },
+  { "Down-Right", 4, 2, { DIR_DOWN, DIR_RIGHT } },
+  { "Down-Left", 5, 2, { DIR_DOWN, DIR_LEFT } },
+  { "Up-Down", 6, 2, { DIR_UP, DIR_DOWN } },
+  { "Left-Right", 7, 2, { DIR_LEFT, DIR_RIGHT } },
+
+  // 容差内的变形：拐角处多出一个斜向
+  { "Down, Down-Right, Right", 4, 3, { DIR_DOWN, DIR_DOWN_RIGHT, DIR_RIGHT } },
+  { "Down, Down-Left, Left", 5, 3, { DIR_DOWN, DIR_DOWN_LEFT, DIR_LEFT } },
+
+  // 不匹配任何模板，或与两个单方向模板代价并列
+  { "Up, Right", GESTURE_NONE, 2, { DIR_UP, DIR_RIGHT } },
+  { "Up, Left", GESTURE_NONE, 2, { DIR_UP, DIR_LEFT } },
+  { "Right, Down", GESTURE_NONE, 2, { DIR_RIGHT, DIR_DOWN } },
+  { "Right, Up", GESTURE_NONE, 2, { DIR_RIGHT, DIR_UP } },
+  { "Left, Down", GESTURE_NONE, 2, { DIR_LEFT, DIR_DOWN } },
+  { "Down-Right diagonal", GESTURE_NONE, 1, { DIR_DOWN_RIGHT } },
+  { "Up-Left diagonal", GESTURE_NONE, 1, { DIR_UP_LEFT } },
+  { "Right, Down, Left, Up", GESTURE_NONE, 4, { DIR_RIGHT, DIR_DOWN, DIR_LEFT, DIR_UP } },
+  { "Right, Left, Right, Left", GESTURE_NONE, 4, { DIR_RIGHT, DIR_LEFT, DIR_RIGHT, DIR_LEFT } },
+  { "Click", GESTURE_NONE, 0, { 0 } },
+};
+
+// 方向码对应的单次报告位移（屏幕坐标，Y 向下为正）
+static const int8_t stepX[8] = { GESTURE_STEP, GESTURE_STEP, 0, -GESTURE_STEP, -GESTURE_STEP, -GESTURE_STEP, 0, GESTURE_STEP };
+static const int8_t stepY[8] = { 0, GESTURE_STEP, GESTURE_STEP, GESTURE_STEP, 0, -GESTURE_STEP, -GESTURE_STEP, -GESTURE_STEP };
+
+static uint8_t runStroke(GestureRecognizer &gesture, const StrokeCase &c) {
+  gesture.begin();
+  for (uint8_t i = 0; i < c.length; i++) {
+    for (uint8_t r = 0; r < REPORTS_PER_SEGMENT; r++) {
+      gesture.addMotion(stepX[c.dirs[i]], stepY[c.dirs[i]]);
+    }
+  }
+  return gesture.end();
+}
+
+static const char *label(uint8_t id) {
+  static const char *const names[GESTURE_COUNT] = {
+    "Right", "Left", "Up", "Down", "Down-Right", "Down-Left", "Up-Down", "Left-Right"
+  };
+  return id < GESTURE_COUNT ? names[id] : "none";
+}
+
+int main() {
+  GestureRecognizer gesture;
+  unsigned failures = 0;
+
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    uint8_t id = runStroke(gesture, cases[i]);
+    bool ok = id == cases[i].expected;
+    printf("%s  %-26s -> %s\n", ok ? "ok  " : "FAIL", cases[i].name, label(id));
+    if (!ok) failures++;
+  }
+
+  // 抖动：单个反向报告不足以确认方向
+  gesture.begin();
+  gesture.addMotion(0, -GESTURE_STEP);
+  for (uint8_t r = 0; r < REPORTS_PER_SEGMENT; r++) gesture.addMotion(GESTURE_STEP, 3);
+  uint8_t id = gesture.end();
+  printf("%s  %-26s -> %s\n", id == 0 ? "ok  " : "FAIL", "Right with jitter", label(id));
+  if (id != 0) failures++;
+
+  if (failures != 0) {
+    printf("%u failures\n", failures);
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}
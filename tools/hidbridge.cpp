@@ -0,0 +1,629 @@
+// Linux 伴随守护进程：串口事件流 -> uinput 虚拟键盘/鼠标
+// 编译: g++ -std=c++11 -O2 -o hidbridge hidbridge.cpp
+// 用法: hidbridge [选项] <串口设备>
+//   --pty        创建伪终端代替串口（测试用），从机路径输出到 stderr
+//   --dry-run    不创建 uinput 设备，只把事件打印到标准输出
+//   --stats N    每 N 秒输出一次统计（缺省 10，0 关闭）
+//   --verbose    同时输出固件日志与无法识别的行
+//   --sync N     每 N 秒与设备同步一次时钟（缺省 2，0 关闭）
+// 每次 read() 得到的数据解析为一批事件，每个设备每批只发送一次 SYN_REPORT。
+// 收到 SIGUSR1 时立即输出统计。
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <linux/input.h>
+#include <linux/uinput.h>
+
+#include "LogDecoder.h"
+
+// HID 键盘用法码 -> Linux 键码 (与内核 hid-input.c 一致，0x00-0x67)
+static const uint8_t hidToLinux[0x68] = {
+    0,   0,   0,   0,  30,  48,  46,  32,  18,  33,  34,  35,  23,  36,  37,  38,
+   50,  49,  24,  25,  16,  19,  31,  20,  22,  47,  17,  45,  21,  44,   2,   3,
+    4,   5,   6,   7,   8,   9,  10,  11,  28,   1,  14,  15,  57,  12,  13,  26,
+   27,  43,  43,  39,  40,  41,  51,  52,  53,  58,  59,  60,  61,  62,  63,  64,
+   65,  66,  67,  68,  87,  88,  99,  70, 119, 110, 102, 104, 111, 107, 109, 106,
+  105, 108, 103,  69,  98,  55,  74,  78,  96,  79,  80,  81,  75,  76,  77,  71,
+   72,  73,  82,  83,  86, 127, 116, 117
+};
+
+// 固件 SerialTextSink::getKeyName 输出的名称 -> HID 用法码
+struct KeyName {
+  const char *name;
+  uint8_t usage;
+};
+
+static const KeyName keyNames[] = {
+  { "ENTER", 0x28 }, { "ESC", 0x29 }, { "BACKSPACE", 0x2A }, { "TAB", 0x2B },
+  { "SPACE", 0x2C }, { "-", 0x2D }, { "=", 0x2E }, { "[", 0x2F }, { "]", 0x30 },
+  { "\\", 0x31 }, { ";", 0x33 }, { "'", 0x34 }, { "`", 0x35 }, { ",", 0x36 },
+  { ".", 0x37 }, { "/", 0x38 }, { "CAPS", 0x39 }, { "RIGHT", 0x4F },
+  { "LEFT", 0x50 }, { "DOWN", 0x51 }, { "UP", 0x52 }
+};
+
+// 修饰符行 "Keyboard: Left Ctrl pressed"
+static const KeyName modifierNames[] = {
+  { "Left Ctrl", KEY_LEFTCTRL }, { "Left Shift", KEY_LEFTSHIFT },
+  { "Left Alt", KEY_LEFTALT }, { "Left Win", KEY_LEFTMETA },
+  { "Right Ctrl", KEY_RIGHTCTRL }, { "Right Shift", KEY_RIGHTSHIFT },
+  { "Right Alt", KEY_RIGHTALT }, { "Right Win", KEY_RIGHTMETA }
+};
+
+static int keyNameToLinux(const std::string &name) {
+  int usage = -1;
+  if (name.size() == 1 && name[0] >= 'A' && name[0] <= 'Z') {
+    usage = 0x04 + (name[0] - 'A');
+  } else if (name.size() == 1 && name[0] >= '1' && name[0] <= '9') {
+    usage = 0x1E + (name[0] - '1');
+  } else if (name == "0") {
+    usage = 0x27;
+  } else if (name.size() >= 2 && name[0] == 'F' && name[1] >= '1' && name[1] <= '9') {
+    int n = atoi(name.c_str() + 1);
+    if (n >= 1 && n <= 12) usage = 0x3A + n - 1;
+  } else if (name.size() == 4 && name[0] == '0' && name[1] == 'x') {
+    usage = (int)strtol(name.c_str() + 2, nullptr, 16);
+  } else {
+    for (size_t i = 0; i < sizeof(keyNames) / sizeof(keyNames[0]); i++) {
+      if (name == keyNames[i].name) {
+        usage = keyNames[i].usage;
+        break;
+      }
+    }
+  }
+  if (usage < 0 || usage >= (int)sizeof(hidToLinux)) return -1;
+  return hidToLinux[usage] ? hidToLinux[usage] : -1;
+}
+
+static bool startsWith(const std::string &s, const char *prefix) {
+  return s.compare(0, strlen(prefix), prefix) == 0;
+}
+
+static uint64_t nowNanos() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// 同步时间基准：CLOCK_REALTIME 微秒的低 32 位，便于与其他日志对齐
+static uint32_t hostMicros32() {
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000);
+}
+
+// 去掉事件行末尾的主机时间戳 " @<us>"，返回是否存在
+static bool stripTimestamp(std::string &line, uint32_t &stamp) {
+  size_t at = line.rfind(" @");
+  if (at == std::string::npos || at + 2 >= line.size()) return false;
+  for (size_t i = at + 2; i < line.size(); i++) {
+    if (line[i] < '0' || line[i] > '9') return false;
+  }
+  stamp = (uint32_t)strtoul(line.c_str() + at + 2, nullptr, 10);
+  line.erase(at);
+  return true;
+}
+
+// 一批待注入的事件
+struct EventBatch {
+  std::vector<input_event> keyboard;
+  std::vector<input_event> mouse;
+
+  void clear() {
+    keyboard.clear();
+    mouse.clear();
+  }
+
+  static void push(std::vector<input_event> &events, uint16_t type, uint16_t code, int32_t value) {
+    input_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.type = type;
+    ev.code = code;
+    ev.value = value;
+    events.push_back(ev);
+  }
+};
+
+// 文本事件行解析器
+class EventParser {
+public:
+  // 打开串口会复位 Arduino，固件坐标从 (0,0) 开始
+  EventParser() : lastX(0), lastY(0) {}
+
+  // 解析一行，返回是否识别
+  bool parse(const std::string &line, EventBatch &batch) {
+    if (startsWith(line, "Keyboard: ")) return parseKeyboard(line.substr(10), batch);
+    if (startsWith(line, "Mouse: ")) return parseMouse(line.substr(7), batch);
+    return false;
+  }
+
+  // 设备重新识别后固件绝对坐标从 (0,0) 开始，首个位移相对原点计算
+  void resetPosition() {
+    lastX = 0;
+    lastY = 0;
+  }
+
+private:
+  static int parseState(const std::string &s, size_t pos) {
+    if (s.compare(pos, 7, "pressed") == 0) return 1;
+    if (s.compare(pos, 8, "released") == 0) return 0;
+    return -1;
+  }
+
+  bool parseKeyboard(const std::string &s, EventBatch &batch) {
+    // "Key 'A' pressed (LShift)"：名称本身可能是 '，从后向前查找
+    if (startsWith(s, "Key '")) {
+      size_t end = s.rfind("' pressed");
+      if (end == std::string::npos || end < 5) end = s.rfind("' released");
+      if (end == std::string::npos || end < 5) return false;
+
+      int code = keyNameToLinux(s.substr(5, end - 5));
+      int state = parseState(s, end + 2);
+      if (code < 0 || state < 0) return false;
+      EventBatch::push(batch.keyboard, EV_KEY, code, state);
+      return true;
+    }
+
+    for (size_t i = 0; i < sizeof(modifierNames) / sizeof(modifierNames[0]); i++) {
+      size_t len = strlen(modifierNames[i].name);
+      if (s.compare(0, len, modifierNames[i].name) == 0 && s.size() > len) {
+        int state = parseState(s, len + 1);
+        if (state < 0) return false;
+        EventBatch::push(batch.keyboard, EV_KEY, modifierNames[i].usage, state);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool parseMouse(const std::string &s, EventBatch &batch) {
+    int x, y, dx, dy, amount;
+    int fields = sscanf(s.c_str(), "Moved to (%d, %d) by (%d, %d)", &x, &y, &dx, &dy);
+    if (fields >= 2) {
+      // 新固件直接给出相对位移；旧固件只有绝对坐标，按 16 位差值还原（坐标回绕时不跳变）
+      if (fields < 4) {
+        dx = (int16_t)(x - lastX);
+        dy = (int16_t)(y - lastY);
+      }
+      if (dx != 0) EventBatch::push(batch.mouse, EV_REL, REL_X, dx);
+      if (dy != 0) EventBatch::push(batch.mouse, EV_REL, REL_Y, dy);
+      lastX = x;
+      lastY = y;
+      return true;
+    }
+    if (sscanf(s.c_str(), "Wheel up %d", &amount) == 1) {
+      EventBatch::push(batch.mouse, EV_REL, REL_WHEEL, amount);
+      return true;
+    }
+    if (sscanf(s.c_str(), "Wheel down %d", &amount) == 1) {
+      EventBatch::push(batch.mouse, EV_REL, REL_WHEEL, -amount);
+      return true;
+    }
+
+    uint16_t button = 0;
+    size_t pos = 0;
+    if (startsWith(s, "Left button ")) {
+      button = BTN_LEFT;
+      pos = 12;
+    } else if (startsWith(s, "Right button ")) {
+      button = BTN_RIGHT;
+      pos = 13;
+    } else if (startsWith(s, "Middle button ")) {
+      button = BTN_MIDDLE;
+      pos = 14;
+    }
+    if (button != 0) {
+      int state = parseState(s, pos);
+      if (state < 0) return false;
+      EventBatch::push(batch.mouse, EV_KEY, button, state);
+      return true;
+    }
+    return false;
+  }
+
+  int lastX;
+  int lastY;
+};
+
+// uinput 虚拟设备
+class UinputDevice {
+public:
+  UinputDevice() : fd(-1) {}
+
+  ~UinputDevice() {
+    if (fd >= 0) {
+      ioctl(fd, UI_DEV_DESTROY);
+      close(fd);
+    }
+  }
+
+  bool createKeyboard() {
+    if (!open()) return false;
+    ioctl(fd, UI_SET_EVBIT, EV_KEY);
+    for (int code = 1; code < 256; code++) {
+      ioctl(fd, UI_SET_KEYBIT, code);
+    }
+    return setup("KBUnderHub Keyboard");
+  }
+
+  bool createMouse() {
+    if (!open()) return false;
+    ioctl(fd, UI_SET_EVBIT, EV_KEY);
+    ioctl(fd, UI_SET_KEYBIT, BTN_LEFT);
+    ioctl(fd, UI_SET_KEYBIT, BTN_RIGHT);
+    ioctl(fd, UI_SET_KEYBIT, BTN_MIDDLE);
+    ioctl(fd, UI_SET_EVBIT, EV_REL);
+    ioctl(fd, UI_SET_RELBIT, REL_X);
+    ioctl(fd, UI_SET_RELBIT, REL_Y);
+    ioctl(fd, UI_SET_RELBIT, REL_WHEEL);
+    return setup("KBUnderHub Mouse");
+  }
+
+  // 一次 write() 注入整批事件并追加 SYN_REPORT
+  bool emit(std::vector<input_event> &events) {
+    if (events.empty()) return true;
+    EventBatch::push(events, EV_SYN, SYN_REPORT, 0);
+    if (fd < 0) return false;
+    size_t bytes = events.size() * sizeof(input_event);
+    return write(fd, events.data(), bytes) == (ssize_t)bytes;
+  }
+
+private:
+  bool open() {
+    fd = ::open("/dev/uinput", O_WRONLY | O_NONBLOCK);
+    if (fd < 0) perror("/dev/uinput");
+    return fd >= 0;
+  }
+
+  bool setup(const char *name) {
+    struct uinput_setup usetup;
+    memset(&usetup, 0, sizeof(usetup));
+    usetup.id.bustype = BUS_USB;
+    usetup.id.vendor = 0x2341;
+    usetup.id.product = 0x0001;
+    strncpy(usetup.name, name, UINPUT_MAX_NAME_SIZE - 1);
+    if (ioctl(fd, UI_DEV_SETUP, &usetup) < 0 || ioctl(fd, UI_DEV_CREATE) < 0) {
+      perror(name);
+      return false;
+    }
+    return true;
+  }
+
+  int fd;
+};
+
+// 时钟同步客户端：每轮发送若干 ping，取往返延迟最小的样本下发给设备
+class SyncClient {
+public:
+  SyncClient() : rounds(0), lastRtt(0), fd(-1), seq(0), pending(false), pongs(0), sentAt(0),
+                 sentNanos(0), bestRtt(UINT32_MAX), bestDevice(0), bestHost(0) {}
+
+  void attach(int serialFd) {
+    fd = serialFd;
+  }
+
+  // 开始新一轮同步
+  void startRound() {
+    if (fd < 0) return;
+    pongs = 0;
+    bestRtt = UINT32_MAX;
+    sendPing();
+  }
+
+  // 处理设备的 MSG_SYNC_PONG(seq, rx, tx)
+  void onPong(const LogRecord &rec) {
+    if (!pending || rec.args.size() < 3 || (uint8_t)rec.args[0] != seq) return;
+    pending = false;
+
+    uint32_t t4 = hostMicros32();
+    uint32_t rx = rec.args[1];
+    uint32_t tx = rec.args[2];
+    uint32_t rtt = (t4 - sentAt) - (tx - rx);
+    if (rtt < bestRtt) {
+      bestRtt = rtt;
+      bestDevice = rx + (tx - rx) / 2;
+      bestHost = sentAt + (t4 - sentAt) / 2;
+    }
+
+    if (++pongs < SYNC_BURST) {
+      sendPing();
+    } else {
+      finishRound();
+    }
+  }
+
+  // 超时未收到回复时用已有样本结束本轮
+  void checkTimeout() {
+    if (pending && nowNanos() - sentNanos > SYNC_TIMEOUT_NANOS) {
+      pending = false;
+      finishRound();
+    }
+  }
+
+  uint32_t rounds;
+  uint32_t lastRtt;  // 最近一轮的最佳往返延迟(us)
+
+private:
+  static const int SYNC_BURST = 4;
+  static const uint64_t SYNC_TIMEOUT_NANOS = 500000000ULL;
+
+  void sendPing() {
+    uint8_t frame[3] = { 0x16, 'P', ++seq };
+    sentAt = hostMicros32();
+    sentNanos = nowNanos();
+    pending = write(fd, frame, sizeof(frame)) == (ssize_t)sizeof(frame);
+  }
+
+  void finishRound() {
+    if (bestRtt == UINT32_MAX) return;
+
+    uint8_t frame[11] = { 0x16, 'S', seq };
+    for (int i = 0; i < 4; i++) {
+      frame[3 + i] = (uint8_t)(bestDevice >> (8 * i));
+      frame[7 + i] = (uint8_t)(bestHost >> (8 * i));
+    }
+    if (write(fd, frame, sizeof(frame)) == (ssize_t)sizeof(frame)) {
+      rounds++;
+      lastRtt = bestRtt;
+    }
+  }
+
+  int fd;
+  uint8_t seq;
+  bool pending;
+  int pongs;
+  uint32_t sentAt;     // ping 发送时刻（主机时间）
+  uint64_t sentNanos;
+  uint32_t bestRtt;
+  uint32_t bestDevice;
+  uint32_t bestHost;
+};
+
+// 吞吐与延迟统计
+struct BridgeStats {
+  uint64_t bytes;
+  uint64_t lines;
+  uint64_t unknownLines;
+  uint64_t logFrames;
+  uint64_t events;
+  uint64_t batches;
+  uint64_t parseNanos;    // 解析耗时累计
+  uint64_t latencyNanos;  // read() 返回到 SYN 写出的累计耗时
+  uint64_t maxLatencyNanos;
+  uint64_t startNanos;
+  uint64_t stampedLines;  // 带主机时间戳的事件行
+  int64_t ageMicros;      // 事件产生到主机解析的累计时间
+  int64_t maxAgeMicros;
+
+  BridgeStats() {
+    memset(this, 0, sizeof(*this));
+    startNanos = nowNanos();
+  }
+
+  void print() const {
+    double elapsed = (nowNanos() - startNanos) / 1e9;
+    fprintf(stderr,
+            "hidbridge: %.1fs, %llu bytes, %llu lines (%llu unknown, %llu log), %llu events in %llu batches\n",
+            elapsed, (unsigned long long)bytes, (unsigned long long)lines,
+            (unsigned long long)unknownLines, (unsigned long long)logFrames,
+            (unsigned long long)events, (unsigned long long)batches);
+    if (lines > 0 && batches > 0) {
+      fprintf(stderr,
+              "hidbridge: parse %.0f ns/line (%.0f lines/s), batch latency avg %.1f us, max %.1f us\n",
+              (double)parseNanos / lines, lines * 1e9 / (parseNanos ? parseNanos : 1),
+              latencyNanos / 1e3 / batches, maxLatencyNanos / 1e3);
+    }
+    if (stampedLines > 0) {
+      fprintf(stderr, "hidbridge: event age avg %.1f us, max %lld us (%llu stamped)\n",
+              (double)ageMicros / stampedLines, (long long)maxAgeMicros,
+              (unsigned long long)stampedLines);
+    }
+  }
+};
+
+static volatile sig_atomic_t running = 1;
+static volatile sig_atomic_t statsRequested = 0;
+
+static void onSignal(int sig) {
+  if (sig == SIGUSR1) {
+    statsRequested = 1;
+  } else {
+    running = 0;
+  }
+}
+
+// 串口设置为 115200 8N1 原始模式
+static void configureSerial(int fd) {
+  struct termios tio;
+  if (tcgetattr(fd, &tio) != 0) return;
+  cfmakeraw(&tio);
+  cfsetispeed(&tio, B115200);
+  cfsetospeed(&tio, B115200);
+  tcsetattr(fd, TCSANOW, &tio);
+}
+
+// 创建伪终端，返回主端；从端保持打开并设为原始模式，避免写端关闭时读到 EIO
+static int openPty(int *slaveFd) {
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+    perror("posix_openpt");
+    return -1;
+  }
+  const char *name = ptsname(master);
+  *slaveFd = open(name, O_RDWR | O_NOCTTY);
+  if (*slaveFd < 0) {
+    perror(name);
+    return -1;
+  }
+  configureSerial(*slaveFd);
+  fprintf(stderr, "hidbridge: pty %s\n", name);
+  return master;
+}
+
+static void printEvents(const char *device, const std::vector<input_event> &events) {
+  for (size_t i = 0; i < events.size(); i++) {
+    printf("%s type=%u code=%u value=%d\n", device, events[i].type, events[i].code, events[i].value);
+  }
+}
+
+int main(int argc, char **argv) {
+  const char *path = nullptr;
+  bool usePty = false;
+  bool dryRun = false;
+  bool verbose = false;
+  int statsInterval = 10;
+  int syncInterval = 2;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--pty") == 0) {
+      usePty = true;
+    } else if (strcmp(argv[i], "--dry-run") == 0) {
+      dryRun = true;
+    } else if (strcmp(argv[i], "--verbose") == 0) {
+      verbose = true;
+    } else if (strcmp(argv[i], "--stats") == 0 && i + 1 < argc) {
+      statsInterval = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--sync") == 0 && i + 1 < argc) {
+      syncInterval = atoi(argv[++i]);
+    } else {
+      path = argv[i];
+    }
+  }
+
+  if (!usePty && path == nullptr) {
+    fprintf(stderr, "usage: %s [--pty] [--dry-run] [--stats N] [--sync N] [--verbose] <serial-device>\n", argv[0]);
+    return 2;
+  }
+
+  int slaveFd = -1;
+  int fd;
+  if (usePty) {
+    fd = openPty(&slaveFd);
+  } else {
+    fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0) perror(path);
+    else configureSerial(fd);
+  }
+  if (fd < 0) return 1;
+
+  UinputDevice keyboard;
+  UinputDevice mouse;
+  if (!dryRun && (!keyboard.createKeyboard() || !mouse.createMouse())) {
+    return 1;
+  }
+
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = onSignal;
+  sigaction(SIGINT, &sa, nullptr);
+  sigaction(SIGTERM, &sa, nullptr);
+  sigaction(SIGUSR1, &sa, nullptr);
+
+  LogDecoder decoder;
+  LogRecord record;
+  EventParser parser;
+  EventBatch batch;
+  BridgeStats stats;
+  SyncClient sync;
+  if (syncInterval > 0) sync.attach(fd);
+  uint64_t lastSync = 0;
+  uint64_t lastStats = nowNanos();
+  uint8_t buf[4096];
+
+  while (running) {
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    int ready = poll(&pfd, 1, 1000);
+
+    if (ready > 0) {
+      ssize_t n = read(fd, buf, sizeof(buf));
+      if (n < 0 && errno != EINTR && errno != EAGAIN) {
+        perror("read");
+        break;
+      }
+      if (n == 0 && !usePty) break;  // 串口关闭
+
+      if (n > 0) {
+        uint64_t batchStart = nowNanos();
+        stats.bytes += n;
+        batch.clear();
+
+        for (ssize_t i = 0; i < n; i++) {
+          if (!decoder.feed(buf[i], record)) continue;
+
+          if (record.isLog) {
+            stats.logFrames++;
+            // 设备重新识别后坐标从零开始
+            if (record.id == MSG_MOUSE_DETECTED) parser.resetPosition();
+            if (record.id == MSG_SYNC_PONG) sync.onPong(record);
+            if (verbose) fprintf(stderr, "log: %s\n", record.text.c_str());
+            continue;
+          }
+
+          uint32_t stamp;
+          if (stripTimestamp(record.text, stamp)) {
+            int64_t age = (int32_t)(hostMicros32() - stamp);
+            stats.stampedLines++;
+            stats.ageMicros += age;
+            if (age > stats.maxAgeMicros) stats.maxAgeMicros = age;
+          }
+
+          uint64_t t0 = nowNanos();
+          bool known = parser.parse(record.text, batch);
+          stats.parseNanos += nowNanos() - t0;
+          stats.lines++;
+          if (!known) {
+            stats.unknownLines++;
+            if (verbose && !record.text.empty()) fprintf(stderr, "text: %s\n", record.text.c_str());
+          }
+        }
+
+        size_t count = batch.keyboard.size() + batch.mouse.size();
+        if (count > 0) {
+          stats.events += count;
+          stats.batches++;
+          if (dryRun) {
+            printEvents("kbd", batch.keyboard);
+            printEvents("mouse", batch.mouse);
+            fflush(stdout);
+          } else {
+            keyboard.emit(batch.keyboard);
+            mouse.emit(batch.mouse);
+          }
+          uint64_t latency = nowNanos() - batchStart;
+          stats.latencyNanos += latency;
+          if (latency > stats.maxLatencyNanos) stats.maxLatencyNanos = latency;
+        }
+      }
+    }
+
+    uint64_t now = nowNanos();
+    if (syncInterval > 0) {
+      sync.checkTimeout();
+      if (now - lastSync >= (uint64_t)syncInterval * 1000000000ULL) {
+        lastSync = now;
+        sync.startRound();
+      }
+    }
+    if (statsRequested || (statsInterval > 0 && now - lastStats >= (uint64_t)statsInterval * 1000000000ULL)) {
+      statsRequested = 0;
+      lastStats = now;
+      stats.print();
+      if (syncInterval > 0) {
+        fprintf(stderr, "hidbridge: %u clock syncs, best rtt %u us\n", sync.rounds, sync.lastRtt);
+      }
+    }
+  }
+
+  stats.print();
+  if (slaveFd >= 0) close(slaveFd);
+  close(fd);
+  return 0;
+}
@@ -0,0 +1,16 @@
+// 主机测试用的最小 Arduino.h：只提供纯整数模块需要的类型与 Flash 访问宏
+#ifndef __HOSTSTUB_ARDUINO_h__
+#define __HOSTSTUB_ARDUINO_h__
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_ptr(p) (*(void *const *)(p))
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+
+#endif  //__HOSTSTUB_ARDUINO_h__
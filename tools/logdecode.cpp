@@ -0,0 +1,62 @@
+// 令牌化日志解码工具
+// 编译: g++ -std=c++11 -O2 -o logdecode logdecode.cpp
+// 用法: logdecode [--table] [串口设备或文件]   (缺省读取标准输入)
+//   --table  输出消息编号与格式串对照表后退出
+
+#include <fcntl.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "LogDecoder.h"
+
+static void printTable() {
+  for (uint8_t i = 0; i < LOG_MESSAGE_COUNT; i++) {
+    printf("%u\t%s\t%s\n", i, logMessageTable[i].name, logMessageTable[i].format);
+  }
+}
+
+// 串口设置为 115200 8N1 原始模式
+static void configureSerial(int fd) {
+  struct termios tio;
+  if (tcgetattr(fd, &tio) != 0) return;  // 普通文件
+  cfmakeraw(&tio);
+  cfsetispeed(&tio, B115200);
+  cfsetospeed(&tio, B115200);
+  tcsetattr(fd, TCSANOW, &tio);
+}
+
+int main(int argc, char **argv) {
+  const char *path = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--table") == 0) {
+      printTable();
+      return 0;
+    }
+    path = argv[i];
+  }
+
+  int fd = STDIN_FILENO;
+  if (path != nullptr) {
+    fd = open(path, O_RDONLY | O_NOCTTY);
+    if (fd < 0) {
+      perror(path);
+      return 1;
+    }
+    configureSerial(fd);
+  }
+
+  LogDecoder decoder;
+  LogRecord record;
+  uint8_t buf[256];
+  ssize_t n;
+  while ((n = read(fd, buf, sizeof(buf))) > 0) {
+    for (ssize_t i = 0; i < n; i++) {
+      if (decoder.feed(buf[i], record)) {
+        printf("%s\n", record.text.c_str());
+      }
+    }
+    fflush(stdout);
+  }
+  return 0;
+}
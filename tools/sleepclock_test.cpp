@@ -0,0 +1,50 @@
+// 低功耗睡眠计时补偿 (PowerManager::timer0Ticks/timer0Overflows) 主机测试
+// 编译: g++ -std=c++11 -O2 -Ihoststub -o sleepclock_test sleepclock_test.cpp
+// 用法: sleepclock_test
+// 遍历睡眠开始时的 TCNT0 相位、实际睡眠时长和 Timer2 估计误差，检查：
+//   还原的 tick 数与实际一致；补偿后 micros() = (溢出计数 << 8) + TCNT0 连续无跳变。
+
+#include <stdio.h>
+
+#include "../PowerManager.h"
+
+#define MAX_ESTIMATE_ERROR 127  // Timer2 估计误差上限（Timer0 tick），需小于半个溢出周期
+
+int main() {
+  unsigned long cases = 0, failures = 0;
+
+  for (uint32_t start = 0; start < 256; start++) {
+    // 实际睡眠时长：覆盖 0 到约 65 秒（uint16_t 毫秒上限）
+    for (uint32_t ticks = 0; ticks < 16384000UL; ticks = ticks * 5 / 4 + 37) {
+      uint8_t end = (uint8_t)(start + ticks);
+
+      for (int32_t error = -MAX_ESTIMATE_ERROR; error <= MAX_ESTIMATE_ERROR; error += 7) {
+        int64_t estimate = (int64_t)ticks + error;
+        if (estimate < 0) estimate = 0;
+        cases++;
+
+        uint32_t restored = PowerManager::timer0Ticks((uint8_t)start, end, (uint32_t)estimate);
+        uint32_t overflows = PowerManager::timer0Overflows((uint8_t)start, restored);
+
+        // 睡眠前后的 micros() 计数（以 tick 为单位），溢出计数任取一个起点
+        uint64_t overflowCount = 1000;
+        uint64_t before = (overflowCount << 8) + start;
+        uint64_t after = ((overflowCount + overflows) << 8) + end;
+
+        if (restored != ticks || after - before != ticks) {
+          if (failures < 10) {
+            printf("FAIL: start %u ticks %u estimate %lld -> restored %u, micros step %llu\n",
+                   (unsigned)start, (unsigned)ticks, (long long)estimate, (unsigned)restored,
+                   (unsigned long long)(after - before));
+          }
+          failures++;
+        }
+      }
+    }
+  }
+
+  printf("%lu cases, %lu failures\n", cases, failures);
+  if (failures != 0) return 1;
+  printf("PASS\n");
+  return 0;
+}
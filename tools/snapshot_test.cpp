@@ -0,0 +1,101 @@
+// 输入状态快照 (InputSnapshot) 主机压力测试：一个写者线程，多个读者线程
+// 编译: g++ -std=c++11 -O2 -pthread -o snapshot_test snapshot_test.cpp ../InputSnapshot.cpp
+// 用法: snapshot_test [写入次数]   (缺省 2000000)
+// 每次写入把同一个值写进全部字段，读者检查字段之间是否一致；
+// 读到不一致的快照（撕裂读）时返回非零。
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../InputSnapshot.h"
+
+#define READER_COUNT 3
+
+static volatile bool writerDone = false;
+
+struct ReaderStats {
+  unsigned long reads;
+  unsigned long retries;  // tryRead() 失败次数
+  unsigned long torn;
+};
+
+// 第 n 次写入的状态：按键位图、修饰符、按键和坐标都由 v 决定
+static inline bool expectKey(uint8_t v, uint8_t code) {
+  return ((v >> (code & 7)) & 1) != 0;
+}
+
+static bool consistent(const InputState &s) {
+  uint8_t v = s.modifiers;
+  if (s.buttons != v || s.x != (int16_t)(v * 3) || s.y != (int16_t)-v) return false;
+  for (int code = 0; code < 256; code++) {
+    if (s.isKeyDown((uint8_t)code) != expectKey(v, (uint8_t)code)) return false;
+  }
+  return true;
+}
+
+static void *writer(void *arg) {
+  unsigned long count = *(unsigned long *)arg;
+  for (unsigned long n = 1; n <= count; n++) {
+    uint8_t v = (uint8_t)n;
+    inputSnapshot.beginWrite();
+    for (int code = 0; code < 256; code++) {
+      inputSnapshot.setKey((uint8_t)code, expectKey(v, (uint8_t)code));
+    }
+    inputSnapshot.setModifiers(v);
+    inputSnapshot.setButtons(v);
+    inputSnapshot.setPosition((int16_t)(v * 3), (int16_t)-v);
+    inputSnapshot.endWrite();
+  }
+  writerDone = true;
+  return nullptr;
+}
+
+static void *reader(void *arg) {
+  ReaderStats *stats = (ReaderStats *)arg;
+  InputState state;
+  while (!writerDone) {
+    // 交替使用单次尝试与自旋读取两种接口
+    if ((stats->reads & 1) == 0) {
+      if (!inputSnapshot.tryRead(state)) {
+        stats->retries++;
+        continue;
+      }
+    } else {
+      inputSnapshot.read(state);
+    }
+    stats->reads++;
+    if ((state.sequence & 1) != 0 || !consistent(state)) stats->torn++;
+  }
+  return nullptr;
+}
+
+int main(int argc, char **argv) {
+  unsigned long count = argc > 1 ? strtoul(argv[1], nullptr, 0) : 2000000UL;
+
+  pthread_t writerThread;
+  pthread_t readerThreads[READER_COUNT];
+  ReaderStats stats[READER_COUNT] = {};
+
+  for (int i = 0; i < READER_COUNT; i++) {
+    pthread_create(&readerThreads[i], nullptr, reader, &stats[i]);
+  }
+  pthread_create(&writerThread, nullptr, writer, &count);
+
+  pthread_join(writerThread, nullptr);
+  unsigned long reads = 0, retries = 0, torn = 0;
+  for (int i = 0; i < READER_COUNT; i++) {
+    pthread_join(readerThreads[i], nullptr);
+    reads += stats[i].reads;
+    retries += stats[i].retries;
+    torn += stats[i].torn;
+  }
+
+  printf("writes %lu, reads %lu, tryRead retries %lu, torn %lu\n", count, reads, retries, torn);
+  if (torn != 0) {
+    printf("FAIL: torn reads detected\n");
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}